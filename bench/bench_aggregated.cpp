@@ -0,0 +1,79 @@
+/** Running sum and maximum with aggregated_static_vector against
+ * recomputing them.
+ *
+ * A series of `state.range(0)` doubles is appended one value at a time, and
+ * the sum and maximum are read after every append, like risk limits checked
+ * on every new position.
+ *
+ * - `recompute` calls std::accumulate and std::max_element over the whole
+ *   static_vector after each append, O(size()) per update.
+ * - `aggregated` reads aggregated_static_vector::aggregate(), which
+ *   push_back keeps up to date, O(1) per update.
+ *
+ * `BM_insert_front` inserts at the front instead, which marks all prefixes
+ * dirty, so aggregate() recomputes them all like `recompute` does.
+ * */
+
+#include "bench_common.hpp"
+
+#include <palotasb/static_vector_aggregated.hpp>
+
+#include <algorithm>
+#include <numeric>
+#include <tuple>
+
+namespace {
+
+constexpr std::size_t capacity = 256;
+
+using plain = stlpb::static_vector<double, capacity>;
+using aggregated = stlpb::aggregated_static_vector<
+    double, capacity,
+    stlpb::aggregates<
+        stlpb::sum_aggregate<double>, stlpb::max_aggregate<double>>>;
+
+double value(std::size_t i) {
+    return static_cast<double>(bench::make_value<int>{}(i) % 1000) * 0.01;
+}
+
+std::tuple<double, double> sum_max(const plain& v) {
+    return std::make_tuple(
+        std::accumulate(v.begin(), v.end(), 0.0),
+        *std::max_element(v.begin(), v.end()));
+}
+std::tuple<double, double> sum_max(const aggregated& v) {
+    return v.aggregate();
+}
+
+template <typename Vector> void BM_append(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    Vector v;
+    for (auto _ : state) {
+        v.clear();
+        for (std::size_t i = 0; i < count; ++i) {
+            v.push_back(value(i));
+            benchmark::DoNotOptimize(sum_max(v));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(count));
+}
+
+template <typename Vector> void BM_insert_front(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    Vector v;
+    for (auto _ : state) {
+        v.clear();
+        for (std::size_t i = 0; i < count; ++i) {
+            v.insert(v.begin(), value(i));
+            benchmark::DoNotOptimize(sum_max(v));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(count));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_append, plain)->Arg(16)->Arg(256);
+BENCHMARK_TEMPLATE(BM_append, aggregated)->Arg(16)->Arg(256);
+BENCHMARK_TEMPLATE(BM_insert_front, plain)->Arg(16)->Arg(256);
+BENCHMARK_TEMPLATE(BM_insert_front, aggregated)->Arg(16)->Arg(256);
@@ -0,0 +1,95 @@
+/** Reassigning a static_vector of strings that is reused across requests.
+ *
+ * Copy assignment and `assign` assign over the existing elements, so a string
+ * keeps its heap buffer when the new value fits. `BM_clear_and_copy` is what
+ * copy assignment used to do: destroy every element and copy construct the
+ * new ones, which frees and allocates one buffer per string. The strings use
+ * a counting allocator and the average number of allocations per iteration
+ * is reported as the `allocations` counter.
+ * */
+
+#include "bench_common.hpp"
+
+using stlpb::static_vector;
+
+namespace {
+
+long allocations = 0;
+
+template <typename T> struct counting_allocator {
+    using value_type = T;
+    counting_allocator() = default;
+    template <typename U> counting_allocator(const counting_allocator<U>&) {}
+    T* allocate(std::size_t n) {
+        ++allocations;
+        return std::allocator<T>().allocate(n);
+    }
+    void deallocate(T* p, std::size_t n) {
+        std::allocator<T>().deallocate(p, n);
+    }
+    template <typename U> bool operator==(const counting_allocator<U>&) const {
+        return true;
+    }
+    template <typename U> bool operator!=(const counting_allocator<U>&) const {
+        return false;
+    }
+};
+
+using string =
+    std::basic_string<char, std::char_traits<char>, counting_allocator<char>>;
+using strings = static_vector<string, 32>;
+
+// A full vector to assign to and `state.range(0)` strings to assign to it
+struct fixture {
+    explicit fixture(const benchmark::State& state) {
+        for (std::size_t i = 0; i < target.capacity(); ++i)
+            target.push_back(value(i));
+        for (long i = 0; i < state.range(0); ++i)
+            source.push_back(value(static_cast<std::size_t>(i) + 1000));
+    }
+    static string value(std::size_t i) {
+        std::string s = bench::make_value<std::string>{}(i);
+        return string(s.begin(), s.end());
+    }
+    strings target;
+    strings source;
+};
+
+template <typename Assign>
+void run(benchmark::State& state, Assign assign) {
+    fixture f(state);
+    allocations = 0;
+    for (auto _ : state) {
+        assign(f.target, f.source);
+        benchmark::DoNotOptimize(f.target.data());
+    }
+    state.counters["allocations"] = benchmark::Counter(
+        static_cast<double>(allocations), benchmark::Counter::kAvgIterations);
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+void BM_clear_and_copy(benchmark::State& state) {
+    run(state, [](strings& target, const strings& source) {
+        target.clear();
+        for (const auto& s : source)
+            target.push_back(s);
+    });
+}
+
+void BM_copy_assign(benchmark::State& state) {
+    run(state, [](strings& target, const strings& source) {
+        target = source;
+    });
+}
+
+void BM_assign_range(benchmark::State& state) {
+    run(state, [](strings& target, const strings& source) {
+        target.assign(source.begin(), source.end());
+    });
+}
+
+} // namespace
+
+BENCHMARK(BM_clear_and_copy)->Arg(8)->Arg(32);
+BENCHMARK(BM_copy_assign)->Arg(8)->Arg(32);
+BENCHMARK(BM_assign_range)->Arg(8)->Arg(32);
@@ -0,0 +1,91 @@
+/** Backtracking with checkpoint and rollback against the workarounds.
+ *
+ * A toy backtracking parser appends tokens for each statement of its input
+ * speculatively: the first alternative appends four tokens and fails for two
+ * of every three statements, then the second alternative appends three
+ * tokens and succeeds. On failure the tokens of the first alternative are
+ * removed again
+ *
+ * - `erase` by erasing the last token until the size before the attempt,
+ * - `copy` by copying the whole vector before the attempt and assigning the
+ *   copy back,
+ * - `rollback` by taking a checkpoint() before the attempt and rolling back
+ *   to it, which for ints only sets the size.
+ * */
+
+#include "bench_common.hpp"
+
+using stlpb::static_vector;
+
+namespace {
+
+constexpr std::size_t statements = 64;
+constexpr std::size_t capacity = 512;
+
+template <typename Token> using tokens = static_vector<Token, capacity>;
+
+struct erase {};
+struct copy {};
+struct rollback {};
+
+template <typename Token>
+void append(tokens<Token>& v, std::size_t statement, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i)
+        v.push_back(bench::make_value<Token>{}(statement * 8 + i));
+}
+
+template <typename Token>
+bool attempt(tokens<Token>& v, std::size_t statement) {
+    append(v, statement, 4);
+    return statement % 3 == 0;
+}
+
+template <typename Token>
+void parse_statement(tokens<Token>& v, std::size_t statement, erase) {
+    const std::size_t size = v.size();
+    if (attempt(v, statement))
+        return;
+    while (v.size() > size)
+        v.erase(v.end() - 1);
+    append(v, statement, 3);
+}
+
+template <typename Token>
+void parse_statement(tokens<Token>& v, std::size_t statement, copy) {
+    const tokens<Token> saved = v;
+    if (attempt(v, statement))
+        return;
+    v = saved;
+    append(v, statement, 3);
+}
+
+template <typename Token>
+void parse_statement(tokens<Token>& v, std::size_t statement, rollback) {
+    const auto mark = v.checkpoint();
+    if (attempt(v, statement))
+        return;
+    v.rollback(mark);
+    append(v, statement, 3);
+}
+
+template <typename Token, typename Strategy>
+void BM_backtrack(benchmark::State& state) {
+    tokens<Token> v;
+    for (auto _ : state) {
+        v.clear();
+        for (std::size_t statement = 0; statement < statements; ++statement)
+            parse_statement(v, statement, Strategy{});
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<long>(statements));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_backtrack, int, erase);
+BENCHMARK_TEMPLATE(BM_backtrack, int, copy);
+BENCHMARK_TEMPLATE(BM_backtrack, int, rollback);
+BENCHMARK_TEMPLATE(BM_backtrack, std::string, erase);
+BENCHMARK_TEMPLATE(BM_backtrack, std::string, copy);
+BENCHMARK_TEMPLATE(BM_backtrack, std::string, rollback);
@@ -0,0 +1,131 @@
+#ifndef PALOTASB_BENCH_COMMON_H
+#define PALOTASB_BENCH_COMMON_H
+
+#pragma once
+
+/** Copyrighted according to the LICENSE file.
+ * SPDX-License-Identifier: MIT
+ * */
+
+/** Shared helpers for the static_vector benchmarks.
+ *
+ * The benchmarks are written against the Google Benchmark API. When the
+ * library is not available the build falls back to minibench.hpp, which
+ * implements the subset used here.
+ * */
+
+#if PALOTASB_HAVE_GOOGLE_BENCHMARK
+#include <benchmark/benchmark.h>
+#else
+#include "minibench.hpp"
+#endif
+
+#include <palotasb/static_vector.hpp>
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+// Element values used by the benchmarks. `i` is only used to make the values
+// distinct so that sorting and comparisons do real work.
+template <typename T> struct make_value;
+
+template <> struct make_value<int> {
+    int operator()(std::size_t i) const {
+        return static_cast<int>((i * 2654435761u) % 1000003u);
+    }
+};
+
+// Strings long enough to defeat the small string optimization, so copies
+// reach the allocator like they do in real message-handling code.
+template <> struct make_value<std::string> {
+    std::string operator()(std::size_t i) const {
+        return "static_vector benchmark value " +
+               std::to_string(make_value<int>{}(i));
+    }
+};
+
+template <> struct make_value<std::unique_ptr<int>> {
+    std::unique_ptr<int> operator()(std::size_t i) const {
+        return std::unique_ptr<int>(new int(make_value<int>{}(i)));
+    }
+};
+
+// Collapse an element to an integer so iteration has something to compute.
+inline long long weigh(int x) { return x; }
+inline long long weigh(const std::string& x) {
+    return static_cast<long long>(x.size()) + x[x.size() - 1];
+}
+inline long long weigh(const std::unique_ptr<int>& x) { return *x; }
+
+// Orders elements by value, also for pointer-like types.
+struct value_less {
+    template <typename T> bool operator()(const T& a, const T& b) const {
+        return a < b;
+    }
+    bool operator()(
+        const std::unique_ptr<int>& a, const std::unique_ptr<int>& b) const {
+        return *a < *b;
+    }
+};
+
+// std::vector that reserves its capacity up front, the usual baseline for
+// containers with a known maximum size.
+template <typename T, std::size_t N> struct reserved_vector : std::vector<T> {
+    reserved_vector() { this->reserve(N); }
+    reserved_vector(const reserved_vector& other) : reserved_vector() {
+        this->insert(this->end(), other.begin(), other.end());
+    }
+    reserved_vector(reserved_vector&&) = default;
+    reserved_vector& operator=(const reserved_vector&) = default;
+    reserved_vector& operator=(reserved_vector&&) = default;
+};
+
+// Compile-time capacity of the benchmarked containers.
+template <typename C> struct capacity_of;
+template <typename T, std::size_t N>
+struct capacity_of<stlpb::static_vector<T, N>> {
+    static const std::size_t value = N;
+};
+template <typename T, std::size_t N> struct capacity_of<reserved_vector<T, N>> {
+    static const std::size_t value = N;
+};
+template <typename T, std::size_t N> struct capacity_of<std::array<T, N>> {
+    static const std::size_t value = N;
+};
+
+template <typename C> using value_type_of = typename C::value_type;
+
+// Pregenerated values so that benchmarks measure the container and not value
+// generation. Copyable values are handed out by reference for copying;
+// move-only values cannot be shared and are generated on demand.
+template <typename T> struct value_pool {
+    explicit value_pool(std::size_t count) {
+        for (std::size_t i = 0; i < count; ++i)
+            values.push_back(make_value<T>{}(i));
+    }
+    const T& operator[](std::size_t i) const { return values[i]; }
+
+    std::vector<T> values;
+};
+template <> struct value_pool<std::unique_ptr<int>> {
+    explicit value_pool(std::size_t) {}
+    std::unique_ptr<int> operator[](std::size_t i) const {
+        return make_value<std::unique_ptr<int>>{}(i);
+    }
+};
+
+// Append `count` values from `pool` to `c`.
+template <typename C>
+void fill(C& c, const value_pool<value_type_of<C>>& pool, std::size_t count) {
+    for (std::size_t i = 0; i < count; ++i)
+        c.push_back(pool[i]);
+}
+
+} // namespace bench
+
+#endif // PALOTASB_BENCH_COMMON_H
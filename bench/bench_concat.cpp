@@ -0,0 +1,61 @@
+/** Merging batches with concat against range insert.
+ *
+ * A pipeline stage produces four batches of at most 16 elements, 12 each
+ * here, and merges them in pairs into one batch of at most 64.
+ *
+ * - `insert` picks capacities by hand, copies the first batch and inserts
+ *   the second one at the end, which checks at run time that it fits.
+ * - `concat` returns static_vector<T, N + M>, which always fits, so there is
+ *   no check and no throwing path.
+ * */
+
+#include "bench_common.hpp"
+
+using stlpb::static_vector;
+
+namespace {
+
+constexpr std::size_t batch_capacity = 16;
+constexpr std::size_t batch_size = 12;
+
+template <typename T> using batch = static_vector<T, batch_capacity>;
+
+struct insert {};
+struct concat {};
+
+template <typename T, std::size_t N>
+static_vector<T, 2 * N>
+merge(const static_vector<T, N>& a, const static_vector<T, N>& b, insert) {
+    static_vector<T, 2 * N> result(a.begin(), a.end());
+    result.insert(result.end(), b.begin(), b.end());
+    return result;
+}
+template <typename T, std::size_t N>
+static_vector<T, 2 * N>
+merge(const static_vector<T, N>& a, const static_vector<T, N>& b, concat) {
+    return stlpb::concat(a, b);
+}
+
+template <typename T, typename Strategy>
+void BM_merge_batches(benchmark::State& state) {
+    std::array<batch<T>, 4> batches;
+    for (std::size_t i = 0; i < batches.size(); ++i)
+        for (std::size_t j = 0; j < batch_size; ++j)
+            batches[i].push_back(bench::make_value<T>{}(i * batch_size + j));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&batches);
+        const auto merged = merge(
+            merge(batches[0], batches[1], Strategy{}),
+            merge(batches[2], batches[3], Strategy{}), Strategy{});
+        benchmark::DoNotOptimize(merged.data());
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<long>(4 * batch_size));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_merge_batches, int, insert);
+BENCHMARK_TEMPLATE(BM_merge_batches, int, concat);
+BENCHMARK_TEMPLATE(BM_merge_batches, std::string, insert);
+BENCHMARK_TEMPLATE(BM_merge_batches, std::string, concat);
@@ -0,0 +1,200 @@
+/** Basic operations of static_vector compared to std::vector with reserved
+ * capacity, std::array and, when available, boost::container::static_vector.
+ *
+ * Every benchmark is instantiated for a trivial (`int`), an allocating
+ * (`std::string`) and a move-only (`std::unique_ptr<int>`) element type and
+ * for several capacities. Containers are filled up to their capacity unless
+ * noted otherwise.
+ * */
+
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <random>
+
+#if PALOTASB_HAVE_BOOST_CONTAINER
+#include <boost/container/static_vector.hpp>
+#endif
+
+using bench::reserved_vector;
+using stlpb::static_vector;
+
+#if PALOTASB_HAVE_BOOST_CONTAINER
+namespace bench {
+template <typename T, std::size_t N>
+struct capacity_of<boost::container::static_vector<T, N>> {
+    static const std::size_t value = N;
+};
+} // namespace bench
+#endif
+
+namespace {
+
+using bench::capacity_of;
+using bench::value_pool;
+using bench::value_type_of;
+
+// Insertion and erasure positions relative to the current size
+struct front {
+    static std::size_t of(std::size_t) { return 0; }
+};
+struct middle {
+    static std::size_t of(std::size_t size) { return size / 2; }
+};
+struct back {
+    static std::size_t of(std::size_t size) { return size; }
+};
+
+// Fill a container with its capacity's worth of values.
+template <typename C>
+void prepare(C& c, const value_pool<value_type_of<C>>& pool) {
+    bench::fill(c, pool, capacity_of<C>::value);
+}
+template <typename T, std::size_t N>
+void prepare(std::array<T, N>& a, const value_pool<T>& pool) {
+    for (std::size_t i = 0; i < N; ++i)
+        a[i] = pool[i];
+}
+
+template <typename C> void BM_default_construct(benchmark::State& state) {
+    for (auto _ : state) {
+        C c{};
+        benchmark::DoNotOptimize(c);
+    }
+}
+
+template <typename C> void BM_push_back(benchmark::State& state) {
+    const std::size_t n = capacity_of<C>::value;
+    value_pool<value_type_of<C>> pool(n);
+    for (auto _ : state) {
+        C c;
+        bench::fill(c, pool, n);
+        benchmark::DoNotOptimize(c.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+
+// Insert one element at `Position` of a half-full container and erase it
+// again, so the size stays the same across iterations and no setup has to be
+// excluded from the timing. Both operations shift the tail.
+template <typename C, typename Position>
+void BM_insert_erase(benchmark::State& state) {
+    const std::size_t n = capacity_of<C>::value;
+    value_pool<value_type_of<C>> pool(n);
+    C c;
+    bench::fill(c, pool, n / 2);
+    value_type_of<C> value = pool[n / 2];
+    for (auto _ : state) {
+        auto pos = c.begin() + Position::of(c.size());
+        auto it = c.insert(pos, std::move(value));
+        value = std::move(*it);
+        c.erase(it);
+        benchmark::ClobberMemory();
+    }
+}
+
+template <typename C> void BM_copy(benchmark::State& state) {
+    value_pool<value_type_of<C>> pool(capacity_of<C>::value);
+    C source{};
+    prepare(source, pool);
+    for (auto _ : state) {
+        C copy(source);
+        benchmark::DoNotOptimize(copy);
+    }
+}
+
+// Move into a new container and back, so that the source is valid again in
+// the next iteration even for containers that steal their buffer.
+template <typename C> void BM_move_round_trip(benchmark::State& state) {
+    value_pool<value_type_of<C>> pool(capacity_of<C>::value);
+    C a{};
+    prepare(a, pool);
+    for (auto _ : state) {
+        C b(std::move(a));
+        benchmark::DoNotOptimize(b);
+        a = std::move(b);
+        benchmark::DoNotOptimize(a);
+    }
+}
+
+template <typename C> void BM_iterate(benchmark::State& state) {
+    value_pool<value_type_of<C>> pool(capacity_of<C>::value);
+    C c{};
+    prepare(c, pool);
+    for (auto _ : state) {
+        long long sum = 0;
+        for (const auto& x : c)
+            sum += bench::weigh(x);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * capacity_of<C>::value);
+}
+
+// Shuffle with a fixed seed, then sort. Shuffling is part of the measured
+// time because the input must be unsorted in every iteration.
+template <typename C> void BM_shuffle_sort(benchmark::State& state) {
+    value_pool<value_type_of<C>> pool(capacity_of<C>::value);
+    C c{};
+    prepare(c, pool);
+    std::mt19937 rng(42);
+    for (auto _ : state) {
+        std::shuffle(c.begin(), c.end(), rng);
+        std::sort(c.begin(), c.end(), bench::value_less{});
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * capacity_of<C>::value);
+}
+
+} // namespace
+
+// Benchmarks that every container supports
+#define SV_BENCH_FIXED(...)                                                    \
+    BENCHMARK_TEMPLATE(BM_default_construct, __VA_ARGS__);                     \
+    BENCHMARK_TEMPLATE(BM_move_round_trip, __VA_ARGS__);                       \
+    BENCHMARK_TEMPLATE(BM_iterate, __VA_ARGS__);                               \
+    BENCHMARK_TEMPLATE(BM_shuffle_sort, __VA_ARGS__)
+
+// Benchmarks for containers with a dynamic size
+#define SV_BENCH_DYNAMIC(...)                                                  \
+    SV_BENCH_FIXED(__VA_ARGS__);                                               \
+    BENCHMARK_TEMPLATE(BM_push_back, __VA_ARGS__);                             \
+    BENCHMARK_TEMPLATE(BM_insert_erase, __VA_ARGS__, front);                   \
+    BENCHMARK_TEMPLATE(BM_insert_erase, __VA_ARGS__, middle);                  \
+    BENCHMARK_TEMPLATE(BM_insert_erase, __VA_ARGS__, back)
+
+#if PALOTASB_HAVE_BOOST_CONTAINER
+#define SV_BENCH_BOOST(T, N)                                                   \
+    SV_BENCH_DYNAMIC(boost::container::static_vector<T, N>)
+#define SV_BENCH_BOOST_COPY(T, N)                                              \
+    BENCHMARK_TEMPLATE(BM_copy, boost::container::static_vector<T, N>)
+#else
+#define SV_BENCH_BOOST(T, N) static_assert(true, "")
+#define SV_BENCH_BOOST_COPY(T, N) static_assert(true, "")
+#endif
+
+// All containers holding `N` elements of type `T`
+#define SV_BENCH_ALL(T, N)                                                     \
+    SV_BENCH_DYNAMIC(static_vector<T, N>);                                     \
+    SV_BENCH_DYNAMIC(reserved_vector<T, N>);                                   \
+    SV_BENCH_FIXED(std::array<T, N>);                                          \
+    SV_BENCH_BOOST(T, N)
+
+#define SV_BENCH_ALL_COPY(T, N)                                                \
+    BENCHMARK_TEMPLATE(BM_copy, static_vector<T, N>);                          \
+    BENCHMARK_TEMPLATE(BM_copy, reserved_vector<T, N>);                        \
+    BENCHMARK_TEMPLATE(BM_copy, std::array<T, N>);                             \
+    SV_BENCH_BOOST_COPY(T, N)
+
+SV_BENCH_ALL(int, 16);
+SV_BENCH_ALL(int, 256);
+SV_BENCH_ALL_COPY(int, 16);
+SV_BENCH_ALL_COPY(int, 256);
+
+SV_BENCH_ALL(std::string, 16);
+SV_BENCH_ALL(std::string, 256);
+SV_BENCH_ALL_COPY(std::string, 16);
+SV_BENCH_ALL_COPY(std::string, 256);
+
+SV_BENCH_ALL(std::unique_ptr<int>, 16);
+SV_BENCH_ALL(std::unique_ptr<int>, 256);
@@ -0,0 +1,74 @@
+/** Deduplicating keys with and without a maintained hash.
+ *
+ * 2^20 keys of 8 to 32 std::uint32_t elements, built with push_back, half of
+ * them duplicates of other keys, are inserted into an std::unordered_set to
+ * count the distinct ones.
+ *
+ * - `static_vector` keys are hashed by std::hash<static_vector>, which reads
+ *   all elements, and compared element by element on bucket collisions.
+ * - `hashed_static_vector` keys update their hash in push_back, so hashing
+ *   is constant time and == rejects unequal keys by their hashes.
+ *
+ * `BM_build` measures the cost of maintaining the hash while building the
+ * keys.
+ * */
+
+#include "bench_common.hpp"
+
+#include <palotasb/static_vector_hashed.hpp>
+
+#include <cstdint>
+#include <unordered_set>
+
+namespace {
+
+constexpr std::size_t capacity = 32;
+constexpr std::size_t key_count = std::size_t(1) << 20;
+
+using plain = stlpb::static_vector<std::uint32_t, capacity>;
+using hashed = stlpb::hashed_static_vector<std::uint32_t, capacity>;
+
+// Key `i`: 8 to 32 elements, equal to key `i - 1` for odd `i`
+template <typename Key> Key make_key(std::size_t i) {
+    const std::size_t seed = i & ~std::size_t(1);
+    Key key;
+    for (std::size_t j = 0; j < 8 + seed % 25; ++j)
+        key.push_back(static_cast<std::uint32_t>(
+            bench::make_value<int>{}(seed * capacity + j)));
+    return key;
+}
+
+template <typename Key> std::vector<Key> make_keys() {
+    std::vector<Key> keys;
+    keys.reserve(key_count);
+    for (std::size_t i = 0; i < key_count; ++i)
+        keys.push_back(make_key<Key>(i));
+    return keys;
+}
+
+template <typename Key> void BM_dedup(benchmark::State& state) {
+    const std::vector<Key> keys = make_keys<Key>();
+    for (auto _ : state) {
+        std::unordered_set<Key> distinct(key_count);
+        for (const Key& key : keys)
+            distinct.insert(key);
+        benchmark::DoNotOptimize(distinct.size());
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<long>(key_count));
+}
+
+template <typename Key> void BM_build(benchmark::State& state) {
+    std::size_t i = 0;
+    for (auto _ : state) {
+        Key key = make_key<Key>(i++);
+        benchmark::DoNotOptimize(key.data());
+    }
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_dedup, plain)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_dedup, hashed)->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_build, plain);
+BENCHMARK_TEMPLATE(BM_build, hashed);
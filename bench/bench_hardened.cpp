@@ -0,0 +1,122 @@
+/** Overhead of the hardened mode checks, per operation.
+ *
+ * - `subscript` reads elements at indices loaded from a table, so the
+ *   compiler cannot prove them in bounds from a loop condition,
+ * - `loop` reads them in an index loop over size(), which proves them in
+ *   bounds so that the checks compile away,
+ * - `back` reads the last element after each push_back,
+ * - `push_pop` fills a static_vector<int, 64> with unchecked_push_back and
+ *   empties it with pop_back,
+ * - `insert_erase` inserts and erases in the middle, checking the position.
+ *
+ * The file is built twice: into `benchmarks`, where the checks compile to
+ * nothing, and into `benchmarks_hardened`, with
+ * PALOTASB_STATIC_VECTOR_HARDENED. Compare the same benchmark of the two.
+ * */
+
+#include "bench_common.hpp"
+
+#include <array>
+
+using stlpb::static_vector;
+
+namespace {
+
+constexpr std::size_t capacity = 64;
+
+static_vector<int, capacity> make_full() {
+    static_vector<int, capacity> v;
+    for (std::size_t i = 0; i < capacity; ++i)
+        v.push_back(bench::make_value<int>{}(i));
+    return v;
+}
+
+void label(benchmark::State& state) {
+#ifdef PALOTASB_STATIC_VECTOR_HARDENED
+    state.SetLabel("hardened build");
+#else
+    (void)state;
+#endif
+}
+
+void BM_hardened_subscript(benchmark::State& state) {
+    const static_vector<int, capacity> v = make_full();
+    std::array<std::size_t, 256> indices;
+    for (std::size_t i = 0; i < indices.size(); ++i)
+        indices[i] = bench::make_value<int>{}(i) % capacity;
+    benchmark::DoNotOptimize(indices.data());
+    for (auto _ : state) {
+        int sum = 0;
+        for (std::size_t index : indices)
+            sum += v[index];
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<long>(indices.size()));
+    label(state);
+}
+
+void BM_hardened_loop(benchmark::State& state) {
+    static_vector<int, capacity> v = make_full();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(v.data());
+        int sum = 0;
+        for (std::size_t i = 0; i < v.size(); ++i)
+            sum += v[i];
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(capacity));
+    label(state);
+}
+
+void BM_hardened_back(benchmark::State& state) {
+    static_vector<int, capacity> v;
+    for (auto _ : state) {
+        int sum = 0;
+        for (std::size_t i = 0; i < capacity; ++i) {
+            v.unchecked_push_back(static_cast<int>(i));
+            sum += v.back();
+        }
+        v.clear();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<long>(capacity));
+    label(state);
+}
+
+void BM_hardened_push_pop(benchmark::State& state) {
+    static_vector<int, capacity> v;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < capacity; ++i)
+            v.unchecked_push_back(static_cast<int>(i));
+        benchmark::ClobberMemory();
+        while (!v.empty())
+            v.pop_back();
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<long>(2 * capacity));
+    label(state);
+}
+
+void BM_hardened_insert_erase(benchmark::State& state) {
+    static_vector<int, capacity> v = make_full();
+    v.resize(capacity / 2);
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < 8; ++i)
+            v.insert(v.begin() + i * 4, static_cast<int>(i));
+        for (std::size_t i = 0; i < 8; ++i)
+            v.erase(v.begin() + i * 3);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * 16);
+    label(state);
+}
+
+} // namespace
+
+BENCHMARK(BM_hardened_subscript);
+BENCHMARK(BM_hardened_loop);
+BENCHMARK(BM_hardened_back);
+BENCHMARK(BM_hardened_push_pop);
+BENCHMARK(BM_hardened_insert_erase);
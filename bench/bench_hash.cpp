@@ -0,0 +1,95 @@
+/** static_vector<std::uint32_t, 16> as an unordered_map key.
+ *
+ * `bulk` uses std::hash<static_vector> and operator==, which hash the
+ * elements eight bytes at a time and compare them with a single memcmp.
+ * `elementwise` is the hand-written hash and equality that were needed
+ * before: std::hash of every element combined one at a time and an element
+ * by element comparison loop.
+ * */
+
+#include "bench_common.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+
+using stlpb::static_vector;
+
+namespace {
+
+using key = static_vector<std::uint32_t, 16>;
+
+struct elementwise {
+    std::size_t operator()(const key& k) const {
+        std::size_t seed = k.size();
+        for (std::uint32_t x : k)
+            seed ^= std::hash<std::uint32_t>{}(x) + 0x9e3779b9 + (seed << 6) +
+                    (seed >> 2);
+        return seed;
+    }
+    bool operator()(const key& a, const key& b) const {
+        if (a.size() != b.size())
+            return false;
+        for (std::size_t i = 0; i < a.size(); ++i)
+            if (a[i] != b[i])
+                return false;
+        return true;
+    }
+};
+
+struct bulk {
+    std::size_t operator()(const key& k) const { return std::hash<key>{}(k); }
+    bool operator()(const key& a, const key& b) const { return a == b; }
+};
+
+// `count` distinct keys of 4 to 16 elements
+std::vector<key> make_keys(std::size_t count) {
+    std::vector<key> keys;
+    for (std::size_t i = 0; i < count; ++i) {
+        key k;
+        for (std::size_t j = 0; j < 4 + i % 13; ++j)
+            k.push_back(static_cast<std::uint32_t>(
+                bench::make_value<int>{}(i * 16 + j)));
+        keys.push_back(k);
+    }
+    return keys;
+}
+
+template <typename Functions> void BM_hash(benchmark::State& state) {
+    auto keys = make_keys(static_cast<std::size_t>(state.range(0)));
+    Functions hash;
+    for (auto _ : state)
+        for (const auto& k : keys)
+            benchmark::DoNotOptimize(hash(k));
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Functions> void BM_equal(benchmark::State& state) {
+    auto keys = make_keys(static_cast<std::size_t>(state.range(0)));
+    auto copies = keys;
+    Functions equal;
+    for (auto _ : state)
+        for (std::size_t i = 0; i < keys.size(); ++i)
+            benchmark::DoNotOptimize(equal(keys[i], copies[i]));
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+template <typename Functions> void BM_map_find(benchmark::State& state) {
+    auto keys = make_keys(static_cast<std::size_t>(state.range(0)));
+    std::unordered_map<key, int, Functions, Functions> map;
+    for (std::size_t i = 0; i < keys.size(); ++i)
+        map.emplace(keys[i], static_cast<int>(i));
+    for (auto _ : state)
+        for (const auto& k : keys)
+            benchmark::DoNotOptimize(map.find(k));
+    state.SetItemsProcessed(state.iterations() * keys.size());
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_hash, elementwise)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_hash, bulk)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_equal, elementwise)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_equal, bulk)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_map_find, elementwise)->Arg(1024)->Arg(65536);
+BENCHMARK_TEMPLATE(BM_map_find, bulk)->Arg(1024)->Arg(65536);
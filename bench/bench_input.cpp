@@ -0,0 +1,77 @@
+/** Parsing whitespace separated numbers from a stream into a container.
+ *
+ * Each iteration reads `state.range(0)` ints from an std::istringstream,
+ *
+ * - `istream_iterator` with the static_vector iterator constructor, which
+ *   reads the single-pass iterators once, checking the capacity per element,
+ * - `push_back` with a `while (in >> x)` loop,
+ * - `via_vector` into an std::vector with its iterator constructor, then
+ *   copied into a static_vector, the workaround while the constructor
+ *   measured the range with std::distance first and so read nothing,
+ * - `vector` into an std::vector only.
+ *
+ * Parsing dominates; the differences are the costs of the containers.
+ * */
+
+#include "bench_common.hpp"
+
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using stlpb::static_vector;
+
+namespace {
+
+constexpr std::size_t capacity = 1024;
+
+using numbers = std::istream_iterator<int>;
+
+std::string make_input(std::size_t count) {
+    std::string input;
+    for (std::size_t i = 0; i < count; ++i)
+        input += std::to_string(bench::make_value<int>{}(i)) + ' ';
+    return input;
+}
+
+struct istream_iterator {};
+struct push_back {};
+struct via_vector {};
+struct vector {};
+
+auto parse(std::istream& in, istream_iterator) {
+    return static_vector<int, capacity>(numbers(in), numbers());
+}
+auto parse(std::istream& in, push_back) {
+    static_vector<int, capacity> v;
+    int x;
+    while (in >> x)
+        v.push_back(x);
+    return v;
+}
+auto parse(std::istream& in, via_vector) {
+    const std::vector<int> parsed{numbers(in), numbers()};
+    return static_vector<int, capacity>(parsed.begin(), parsed.end());
+}
+auto parse(std::istream& in, vector) {
+    return std::vector<int>{numbers(in), numbers()};
+}
+
+template <typename Method> void BM_parse(benchmark::State& state) {
+    const std::string input = make_input(static_cast<std::size_t>(
+        state.range(0)));
+    for (auto _ : state) {
+        std::istringstream in(input);
+        auto v = parse(in, Method{});
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_parse, istream_iterator)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_parse, push_back)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_parse, via_vector)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_parse, vector)->Arg(64)->Arg(1024);
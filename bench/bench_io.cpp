@@ -0,0 +1,107 @@
+/** Reading a file into a static_vector<char, 64 KiB> chunk by chunk.
+ *
+ * Each iteration reads a 16 MiB temporary file, which stays in the page
+ * cache, with pread(2) in chunks of `state.range(0)` bytes,
+ *
+ * - `direct` with append_from_fd_at, which reads into the unused slots,
+ * - `copy_through` into a local buffer, then assigned to the static_vector,
+ * - `vector` into an std::vector<char> resized to the chunk, which
+ *   zero-fills it first.
+ *
+ * The kernel copy from the page cache dominates; the differences are the
+ * second copy and the zero-filling.
+ * */
+
+#include "bench_common.hpp"
+
+#include <palotasb/static_vector_io.hpp>
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include <unistd.h>
+
+using stlpb::static_vector;
+
+namespace {
+
+constexpr std::size_t capacity = 64 * 1024;
+constexpr std::size_t file_size = 16 * 1024 * 1024;
+
+// A file descriptor of an unlinked temporary file of `file_size` bytes
+int input_file() {
+    static const int fd = [] {
+        char path[] = "/tmp/palotasb_bench_io_XXXXXX";
+        const int fd = ::mkstemp(path);
+        if (fd < 0) {
+            std::perror("mkstemp");
+            std::exit(1);
+        }
+        ::unlink(path);
+        std::vector<char> contents(file_size);
+        for (std::size_t i = 0; i < file_size; ++i)
+            contents[i] = static_cast<char>(bench::make_value<int>{}(i));
+        if (::write(fd, contents.data(), file_size) !=
+            static_cast<ssize_t>(file_size)) {
+            std::perror("write");
+            std::exit(1);
+        }
+        return fd;
+    }();
+    return fd;
+}
+
+struct direct {};
+struct copy_through {};
+struct vector {};
+
+std::size_t read_chunk(static_vector<char, capacity>& v, int fd, off_t offset,
+                       std::size_t chunk, direct) {
+    v.clear();
+    return stlpb::append_from_fd_at(v, fd, offset, chunk);
+}
+std::size_t read_chunk(static_vector<char, capacity>& v, int fd, off_t offset,
+                       std::size_t chunk, copy_through) {
+    std::array<char, capacity> buffer;
+    const ssize_t n = ::pread(fd, buffer.data(), chunk, offset);
+    v.assign(buffer.begin(), buffer.begin() + (n > 0 ? n : 0));
+    return v.size();
+}
+std::size_t read_chunk(std::vector<char>& v, int fd, off_t offset,
+                       std::size_t chunk, vector) {
+    v.clear();
+    v.resize(chunk);
+    const ssize_t n = ::pread(fd, v.data(), chunk, offset);
+    v.resize(n > 0 ? static_cast<std::size_t>(n) : 0);
+    return v.size();
+}
+
+template <typename Method> struct container {
+    using type = static_vector<char, capacity>;
+};
+template <> struct container<vector> {
+    using type = std::vector<char>;
+};
+
+template <typename Method> void BM_read_file(benchmark::State& state) {
+    const int fd = input_file();
+    const auto chunk = static_cast<std::size_t>(state.range(0));
+    typename container<Method>::type v;
+    for (auto _ : state) {
+        for (std::size_t offset = 0; offset < file_size; offset += chunk) {
+            read_chunk(v, fd, static_cast<off_t>(offset), chunk, Method{});
+            benchmark::DoNotOptimize(v.data());
+            benchmark::ClobberMemory();
+        }
+    }
+    state.SetBytesProcessed(
+        state.iterations() * static_cast<std::int64_t>(file_size));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_read_file, direct)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(BM_read_file, copy_through)->Arg(4096)->Arg(65536);
+BENCHMARK_TEMPLATE(BM_read_file, vector)->Arg(4096)->Arg(65536);
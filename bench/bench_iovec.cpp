@@ -0,0 +1,136 @@
+/** Writing a message of many pieces to a pipe and to a file.
+ *
+ * Each iteration writes a 16 byte header and `state.range(0)` payloads of
+ * `state.range(1)` bytes,
+ *
+ * - `gather` collects them in a static_iovec_builder, copying the header
+ *   into its inline storage and referencing the payloads, and writes them
+ *   with one writev(2),
+ * - `concatenate` appends them to a reused std::string and writes that with
+ *   write(2).
+ *
+ * The pipe is drained by a thread; the file is an unlinked temporary file
+ * that is rewound before each message. The kernel copies the pieces of a
+ * writev(2) one iovec at a time, so concatenating pieces of up to a few
+ * KiB is faster and gathering pays off for larger ones.
+ * */
+
+#include "bench_common.hpp"
+
+#include <palotasb/static_vector_io.hpp>
+
+#include <array>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr std::size_t max_pieces = 64;
+
+struct gather {};
+struct concatenate {};
+
+struct message {
+    message(std::size_t pieces, std::size_t piece_size) : header(16, 'h') {
+        for (std::size_t i = 0; i < pieces; ++i)
+            payloads.emplace_back(piece_size, static_cast<char>('a' + i % 26));
+    }
+    std::string header;
+    std::vector<std::string> payloads;
+};
+
+std::size_t write_message(int fd, const message& m, gather) {
+    stlpb::static_iovec_builder<max_pieces + 1, 16> builder;
+    builder.append_copy(m.header.data(), m.header.size());
+    for (const std::string& payload : m.payloads)
+        builder.append(payload);
+    return builder.write_to(fd);
+}
+std::size_t write_message(int fd, const message& m, concatenate) {
+    static std::string buffer;
+    buffer.clear();
+    buffer += m.header;
+    for (const std::string& payload : m.payloads)
+        buffer += payload;
+    std::size_t written = 0;
+    while (written < buffer.size()) {
+        const ssize_t n =
+            ::write(fd, buffer.data() + written, buffer.size() - written);
+        if (n < 0) {
+            std::perror("write");
+            std::exit(1);
+        }
+        written += static_cast<std::size_t>(n);
+    }
+    return written;
+}
+
+template <typename Method> void BM_iovec_pipe(benchmark::State& state) {
+    const message m(static_cast<std::size_t>(state.range(0)),
+                    static_cast<std::size_t>(state.range(1)));
+    int fds[2];
+    if (::pipe(fds) != 0) {
+        std::perror("pipe");
+        std::exit(1);
+    }
+    std::thread reader([fd = fds[0]] {
+        std::array<char, 65536> buffer;
+        while (::read(fd, buffer.data(), buffer.size()) > 0) {
+        }
+    });
+    std::size_t bytes = 0;
+    for (auto _ : state)
+        bytes += write_message(fds[1], m, Method{});
+    ::close(fds[1]);
+    reader.join();
+    ::close(fds[0]);
+    state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+}
+
+template <typename Method> void BM_iovec_file(benchmark::State& state) {
+    const message m(static_cast<std::size_t>(state.range(0)),
+                    static_cast<std::size_t>(state.range(1)));
+    char path[] = "/tmp/palotasb_bench_iovec_XXXXXX";
+    const int fd = ::mkstemp(path);
+    if (fd < 0) {
+        std::perror("mkstemp");
+        std::exit(1);
+    }
+    ::unlink(path);
+    std::size_t bytes = 0;
+    for (auto _ : state) {
+        ::lseek(fd, 0, SEEK_SET);
+        bytes += write_message(fd, m, Method{});
+    }
+    ::close(fd);
+    state.SetBytesProcessed(static_cast<std::int64_t>(bytes));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_iovec_pipe, gather)
+    ->Args({8, 64})
+    ->Args({8, 1024})
+    ->Args({64, 512})
+    ->Args({4, 16384});
+BENCHMARK_TEMPLATE(BM_iovec_pipe, concatenate)
+    ->Args({8, 64})
+    ->Args({8, 1024})
+    ->Args({64, 512})
+    ->Args({4, 16384});
+BENCHMARK_TEMPLATE(BM_iovec_file, gather)
+    ->Args({8, 64})
+    ->Args({8, 1024})
+    ->Args({64, 512})
+    ->Args({4, 16384});
+BENCHMARK_TEMPLATE(BM_iovec_file, concatenate)
+    ->Args({8, 64})
+    ->Args({8, 1024})
+    ->Args({64, 512})
+    ->Args({4, 16384});
@@ -0,0 +1,82 @@
+/** Memory layout: where the size is and how static_vectors are aligned.
+ *
+ * - `BM_size_front` reads size() and front() of each of many large vectors.
+ *   static_vector keeps its size in front of the elements, so both are on
+ *   the same cache line. `trailer_vector` emulates the layout before
+ *   static_vector_ref, with the size after the element array, which costs a
+ *   second cache miss per vector.
+ * - `BM_per_thread` has each thread push and pop on its own small
+ *   static_vector in a shared array. With the default policy neighbouring
+ *   vectors share cache lines (false sharing); cache_aligned_policy gives
+ *   each vector its own lines. This needs more than one core to show.
+ * */
+
+#include "bench_common.hpp"
+
+#include <thread>
+
+using stlpb::static_vector;
+
+namespace {
+
+constexpr std::size_t large = 1024;
+constexpr std::size_t vector_count = 2048;
+
+// Size after the elements
+struct trailer_vector {
+    std::array<int, large> elements;
+    std::size_t count;
+
+    std::size_t size() const { return count; }
+    int front() const { return elements[0]; }
+};
+
+void add_one(trailer_vector& v) {
+    v.elements[0] = 1;
+    v.count = 1;
+}
+void add_one(static_vector<int, large>& v) { v.push_back(1); }
+
+template <typename Vector> void BM_size_front(benchmark::State& state) {
+    std::vector<Vector> vectors(vector_count);
+    for (auto& v : vectors)
+        add_one(v);
+    for (auto _ : state) {
+        long sum = 0;
+        for (const auto& v : vectors)
+            if (v.size() > 0)
+                sum += v.front();
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * vector_count);
+}
+
+template <typename Policy> void BM_per_thread(benchmark::State& state) {
+    using vector = static_vector<int, 4, Policy>;
+    const auto thread_count = static_cast<std::size_t>(state.range(0));
+    const long operations = 100000;
+    std::vector<vector> vectors(thread_count);
+    for (auto _ : state) {
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < thread_count; ++t)
+            threads.emplace_back([&vectors, t, operations] {
+                vector& v = vectors[t];
+                for (long i = 0; i < operations; ++i) {
+                    v.push_back(static_cast<int>(i));
+                    benchmark::DoNotOptimize(v.back());
+                    v.pop_back();
+                }
+            });
+        for (auto& thread : threads)
+            thread.join();
+    }
+    state.SetItemsProcessed(
+        state.iterations() * static_cast<long>(thread_count) * operations);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_size_front, static_vector<int, large>);
+BENCHMARK_TEMPLATE(BM_size_front, trailer_vector);
+BENCHMARK_TEMPLATE(BM_per_thread, stlpb::static_vector_policy)->Arg(2)->Arg(4);
+BENCHMARK_TEMPLATE(BM_per_thread, stlpb::cache_aligned_policy)->Arg(2)->Arg(4);
@@ -0,0 +1,3 @@
+#include "bench_common.hpp"
+
+BENCHMARK_MAIN();
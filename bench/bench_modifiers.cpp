@@ -0,0 +1,146 @@
+/** emplace_back, pop_back, resize and swap against the workarounds that were
+ * needed before they existed.
+ *
+ * - `push_back(T(...))` constructs a temporary and moves it, emplace_back
+ *   constructs in place.
+ * - `erase(end() - 1)` goes through the general erase, pop_back only destroys
+ *   the last element.
+ * - Growing with a push_back loop checks the capacity per element, resize
+ *   checks it once; `resize(n, stlpb::default_init)` also skips zeroing.
+ * - Swapping through a temporary is three whole-container moves. swap swaps
+ *   the common prefix and moves the rest, or for trivially relocatable types
+ *   copies the bytes of both through a buffer.
+ * */
+
+#include "bench_common.hpp"
+
+#include <utility>
+
+using stlpb::static_vector;
+
+namespace {
+
+constexpr std::size_t capacity = 64;
+const char* const text = "static_vector benchmark emplaced value";
+
+void BM_push_back_temporary(benchmark::State& state) {
+    static_vector<std::string, capacity> v;
+    for (auto _ : state) {
+        v.clear();
+        for (std::size_t i = 0; i < capacity; ++i)
+            v.push_back(std::string(text, 24 + i % 8));
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+}
+
+void BM_emplace_back(benchmark::State& state) {
+    static_vector<std::string, capacity> v;
+    for (auto _ : state) {
+        v.clear();
+        for (std::size_t i = 0; i < capacity; ++i)
+            v.emplace_back(text, 24 + i % 8);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+}
+
+// Append one element to a half-full vector and remove it again
+template <typename T> void BM_erase_last(benchmark::State& state) {
+    bench::value_pool<T> pool(capacity);
+    static_vector<T, capacity> v;
+    bench::fill(v, pool, capacity / 2);
+    for (auto _ : state) {
+        v.push_back(pool[0]);
+        v.erase(v.end() - 1);
+        benchmark::ClobberMemory();
+    }
+}
+
+template <typename T> void BM_pop_back(benchmark::State& state) {
+    bench::value_pool<T> pool(capacity);
+    static_vector<T, capacity> v;
+    bench::fill(v, pool, capacity / 2);
+    for (auto _ : state) {
+        v.push_back(pool[0]);
+        v.pop_back();
+        benchmark::ClobberMemory();
+    }
+}
+
+void BM_grow_push_back(benchmark::State& state) {
+    static_vector<int, capacity> v;
+    for (auto _ : state) {
+        v.clear();
+        for (std::size_t i = 0; i < capacity; ++i)
+            v.push_back(0);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+}
+
+void BM_resize(benchmark::State& state) {
+    static_vector<int, capacity> v;
+    for (auto _ : state) {
+        v.clear();
+        v.resize(capacity);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+}
+
+void BM_resize_default_init(benchmark::State& state) {
+    static_vector<int, capacity> v;
+    for (auto _ : state) {
+        v.clear();
+        v.resize(capacity, stlpb::default_init);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * capacity);
+}
+
+// Vectors of `state.range(0)` and `state.range(0) / 2` elements
+template <typename T, typename Swap>
+void run_swap(benchmark::State& state, Swap swap) {
+    const auto size = static_cast<std::size_t>(state.range(0));
+    bench::value_pool<T> pool(size);
+    static_vector<T, capacity> a;
+    static_vector<T, capacity> b;
+    bench::fill(a, pool, size);
+    bench::fill(b, pool, size / 2);
+    for (auto _ : state) {
+        swap(a, b);
+        benchmark::DoNotOptimize(a.data());
+        benchmark::DoNotOptimize(b.data());
+    }
+}
+
+template <typename T> void BM_swap_three_moves(benchmark::State& state) {
+    run_swap<T>(state, [](static_vector<T, capacity>& a,
+                          static_vector<T, capacity>& b) {
+        static_vector<T, capacity> tmp(std::move(a));
+        a = std::move(b);
+        b = std::move(tmp);
+    });
+}
+
+template <typename T> void BM_swap(benchmark::State& state) {
+    run_swap<T>(state, [](static_vector<T, capacity>& a,
+                          static_vector<T, capacity>& b) { a.swap(b); });
+}
+
+} // namespace
+
+BENCHMARK(BM_push_back_temporary);
+BENCHMARK(BM_emplace_back);
+BENCHMARK_TEMPLATE(BM_erase_last, int);
+BENCHMARK_TEMPLATE(BM_pop_back, int);
+BENCHMARK_TEMPLATE(BM_erase_last, std::string);
+BENCHMARK_TEMPLATE(BM_pop_back, std::string);
+BENCHMARK(BM_grow_push_back);
+BENCHMARK(BM_resize);
+BENCHMARK(BM_resize_default_init);
+BENCHMARK_TEMPLATE(BM_swap_three_moves, int)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_swap, int)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_swap_three_moves, std::string)->Arg(16)->Arg(64);
+BENCHMARK_TEMPLATE(BM_swap, std::string)->Arg(16)->Arg(64);
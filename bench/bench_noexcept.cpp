@@ -0,0 +1,48 @@
+/** Growing a std::vector of static_vectors.
+ *
+ * std::vector moves its elements into the new buffer when reallocating only
+ * if their move constructor is noexcept, and copies them otherwise. Before
+ * static_vector's move constructor was conditionally noexcept, a
+ * std::vector<static_vector<std::string, 16>> copied every string on every
+ * reallocation. `potentially_throwing_move` restores that behaviour for
+ * comparison.
+ * */
+
+#include "bench_common.hpp"
+
+using stlpb::static_vector;
+
+namespace {
+
+using strings = static_vector<std::string, 16>;
+
+// Same as `strings` but with a move constructor that is not noexcept
+struct potentially_throwing_move : strings {
+    using strings::strings;
+    potentially_throwing_move(const potentially_throwing_move&) = default;
+    potentially_throwing_move(potentially_throwing_move&& other) noexcept(
+        false)
+        : strings(std::move(other)) {}
+};
+
+template <typename Element> void BM_vector_growth(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    bench::value_pool<std::string> pool(16);
+    Element element;
+    bench::fill(element, pool, 16);
+    for (auto _ : state) {
+        std::vector<Element> v;
+        for (std::size_t i = 0; i < count; ++i)
+            v.push_back(element);
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * count);
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_vector_growth, strings)->Arg(16)->Arg(256)->Arg(4096);
+BENCHMARK_TEMPLATE(BM_vector_growth, potentially_throwing_move)
+    ->Arg(16)
+    ->Arg(256)
+    ->Arg(4096);
@@ -0,0 +1,57 @@
+/** Overhead of the observer hooks.
+ *
+ * Each iteration fills a static_vector<int, 64> with push_back, inserts and
+ * erases in the middle, and empties it with pop_back, about 200 observable
+ * events. The file is built twice:
+ *
+ * - into `benchmarks`, without PALOTASB_STATIC_VECTOR_OBSERVE, where the
+ *   hooks compile to nothing,
+ * - into `benchmarks_observe`, with it, for the default policy (a null
+ *   observer pointer tested per event), counting_observer and
+ *   trace_observer.
+ * */
+
+#include "bench_common.hpp"
+
+#include <palotasb/static_vector_observers.hpp>
+
+using stlpb::static_vector;
+
+namespace {
+
+constexpr std::size_t capacity = 64;
+
+#ifdef PALOTASB_STATIC_VECTOR_OBSERVE
+struct counting_policy : stlpb::static_vector_policy {
+    using observer = stlpb::counting_observer;
+};
+struct trace_policy : stlpb::static_vector_policy {
+    using observer = stlpb::trace_observer;
+};
+#endif
+
+template <typename Policy> void BM_observed_ops(benchmark::State& state) {
+    static_vector<int, capacity, Policy> v;
+    for (auto _ : state) {
+        for (std::size_t i = 0; i < capacity / 2; ++i)
+            v.push_back(static_cast<int>(i));
+        for (std::size_t i = 0; i < capacity / 2; ++i)
+            v.insert(v.begin() + i, static_cast<int>(i));
+        for (std::size_t i = 0; i < capacity / 4; ++i)
+            v.erase(v.begin() + i);
+        while (!v.empty())
+            v.pop_back();
+        benchmark::ClobberMemory();
+    }
+#ifdef PALOTASB_STATIC_VECTOR_OBSERVE
+    state.SetLabel("observe build");
+#endif
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_observed_ops, stlpb::static_vector_policy);
+#ifdef PALOTASB_STATIC_VECTOR_OBSERVE
+BENCHMARK_TEMPLATE(BM_observed_ops, counting_policy);
+BENCHMARK_TEMPLATE(BM_observed_ops, trace_policy);
+#endif
@@ -0,0 +1,91 @@
+/** Materializing C++20 view pipelines into containers.
+ *
+ * Each iteration turns `state.range(0)` integers into a container through
+ *
+ * - a sized pipeline, `iota | transform`, whose size is known up front,
+ * - an unsized one, `iota | filter | transform`, which keeps half of them
+ *   and can only be read once without evaluating the filter twice.
+ *
+ * - `from_range` constructs a static_vector from the pipeline, with one
+ *   capacity check for the sized pipeline and one per element otherwise,
+ * - `push_back` appends each element of the pipeline to a static_vector,
+ * - `vector` copies the pipeline into a std::vector with reserved capacity,
+ *   the usual C++20 way without std::ranges::to.
+ *
+ * Only built into `benchmarks_cxx20`, in C++20 builds.
+ * */
+
+#include "bench_common.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <ranges>
+#include <vector>
+
+using stlpb::static_vector;
+
+namespace {
+
+constexpr std::size_t capacity = 1024;
+
+auto sized(std::size_t count) {
+    return std::views::iota(std::size_t(0), count) |
+           std::views::transform([](std::size_t i) {
+               return bench::make_value<int>{}(i);
+           });
+}
+
+auto unsized(std::size_t count) {
+    return std::views::iota(std::size_t(0), count) |
+           std::views::filter([](std::size_t i) { return i % 2 == 0; }) |
+           std::views::transform([](std::size_t i) {
+               return bench::make_value<int>{}(i);
+           });
+}
+
+struct from_range {};
+struct push_back {};
+struct vector {};
+
+template <typename Range> auto materialize(Range&& range, from_range) {
+    return static_vector<int, capacity>(stlpb::from_range, range);
+}
+template <typename Range> auto materialize(Range&& range, push_back) {
+    static_vector<int, capacity> v;
+    for (int x : range)
+        v.push_back(x);
+    return v;
+}
+template <typename Range> auto materialize(Range&& range, vector) {
+    std::vector<int> v;
+    v.reserve(capacity);
+    std::ranges::copy(range, std::back_inserter(v));
+    return v;
+}
+
+template <typename Method> void BM_sized(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        auto v = materialize(sized(count), Method{});
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+template <typename Method> void BM_unsized(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    for (auto _ : state) {
+        auto v = materialize(unsized(count), Method{});
+        benchmark::DoNotOptimize(v.data());
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_sized, from_range)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_sized, push_back)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_sized, vector)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_unsized, from_range)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_unsized, push_back)->Arg(64)->Arg(1024);
+BENCHMARK_TEMPLATE(BM_unsized, vector)->Arg(64)->Arg(1024);
@@ -0,0 +1,76 @@
+/** Middle insertion and erasure with and without trivial relocation.
+ *
+ * Elements that are trivially relocatable (see
+ * stlpb::is_trivially_relocatable) are shifted with one memmove, others with
+ * one move assignment per element. Each element type is benchmarked in both
+ * variants: `std::unique_ptr<int>` against an otherwise identical opted-in
+ * wrapper, and a 64-byte trivially copyable struct against a copy with a
+ * user-provided copy constructor, which is not relocatable.
+ * */
+
+#include "bench_common.hpp"
+
+#include <cstring>
+
+using stlpb::static_vector;
+
+namespace {
+
+// std::unique_ptr<int> opted in to trivial relocation
+struct relocatable_ptr {
+    relocatable_ptr(int v) : p(new int(v)) {}
+    std::unique_ptr<int> p;
+};
+
+// 64 bytes of plain data
+struct pod64 {
+    pod64(int v = 0) { std::memset(values, v & 0xff, sizeof(values)); }
+    char values[64];
+};
+
+// The same, but not trivially copyable and therefore not relocatable
+struct nontrivial64 : pod64 {
+    using pod64::pod64;
+    nontrivial64(const nontrivial64& other) : pod64(other) {}
+    nontrivial64& operator=(const nontrivial64&) = default;
+};
+
+} // namespace
+
+namespace stlpb {
+template <> struct is_trivially_relocatable<relocatable_ptr> : std::true_type {};
+} // namespace stlpb
+
+namespace {
+
+template <typename T> T make(int i) { return T(i); }
+template <> std::unique_ptr<int> make<std::unique_ptr<int>>(int i) {
+    return std::unique_ptr<int>(new int(i));
+}
+
+// Insert one element in the middle of a half-full vector and erase it again
+template <typename T, std::size_t N>
+void BM_insert_erase_middle(benchmark::State& state) {
+    static_vector<T, N> v;
+    for (std::size_t i = 0; i < N / 2; ++i)
+        v.push_back(make<T>(static_cast<int>(i)));
+    T value = make<T>(-1);
+    for (auto _ : state) {
+        auto it = v.insert(v.begin() + v.size() / 2, std::move(value));
+        value = std::move(*it);
+        v.erase(it);
+        benchmark::ClobberMemory();
+    }
+}
+
+} // namespace
+
+#define SV_BENCH_RELOCATION(T)                                                 \
+    BENCHMARK_TEMPLATE(BM_insert_erase_middle, T, 16);                         \
+    BENCHMARK_TEMPLATE(BM_insert_erase_middle, T, 64);                         \
+    BENCHMARK_TEMPLATE(BM_insert_erase_middle, T, 256)
+
+SV_BENCH_RELOCATION(std::unique_ptr<int>);
+SV_BENCH_RELOCATION(relocatable_ptr);
+SV_BENCH_RELOCATION(nontrivial64);
+SV_BENCH_RELOCATION(pod64);
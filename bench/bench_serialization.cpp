@@ -0,0 +1,91 @@
+/** Round trips of a static_vector of records through a byte buffer.
+ *
+ * Each iteration serializes `state.range(0)` 24 byte records into a buffer
+ * and reads them back into another static_vector,
+ *
+ * - `single_memcpy` with serialize_into and deserialize_from, a single
+ *   memcpy of the elements each way,
+ * - `naive` with a count followed by the records, each copied on its own,
+ *   and read back with push_back.
+ * */
+
+#include "bench_common.hpp"
+
+#include <palotasb/static_vector_serialization.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using stlpb::static_vector;
+
+namespace {
+
+constexpr std::size_t capacity = 1024;
+
+struct record {
+    std::uint64_t id;
+    double price;
+    std::int32_t quantity;
+    std::uint32_t flags;
+};
+
+using records = static_vector<record, capacity>;
+
+struct single_memcpy {};
+struct naive {};
+
+void round_trip(const records& in, unsigned char* buffer, std::size_t size,
+                records& out, single_memcpy) {
+    const std::size_t written = stlpb::serialize_into(in, buffer, size);
+    stlpb::deserialize_from(out, buffer, written);
+}
+void round_trip(const records& in, unsigned char* buffer, std::size_t,
+                records& out, naive) {
+    const std::uint64_t count = in.size();
+    std::memcpy(buffer, &count, sizeof(count));
+    unsigned char* p = buffer + sizeof(count);
+    for (const record& r : in) {
+        std::memcpy(p, &r, sizeof(r));
+        p += sizeof(r);
+    }
+    std::uint64_t read_count;
+    std::memcpy(&read_count, buffer, sizeof(read_count));
+    const unsigned char* q = buffer + sizeof(read_count);
+    out.clear();
+    for (std::uint64_t i = 0; i < read_count; ++i) {
+        record r;
+        std::memcpy(&r, q, sizeof(r));
+        q += sizeof(r);
+        out.push_back(r);
+    }
+}
+
+template <typename Method>
+void BM_serialize_round_trip(benchmark::State& state) {
+    const auto count = static_cast<std::size_t>(state.range(0));
+    records in;
+    for (std::size_t i = 0; i < count; ++i)
+        in.push_back(record{i, 0.5 * static_cast<double>(i),
+                            bench::make_value<int>{}(i), 0});
+    records out;
+    std::vector<unsigned char> buffer(16 + capacity * sizeof(record));
+    for (auto _ : state) {
+        round_trip(in, buffer.data(), buffer.size(), out, Method{});
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetBytesProcessed(state.iterations() *
+                            static_cast<std::int64_t>(count * sizeof(record)));
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_serialize_round_trip, single_memcpy)
+    ->Arg(8)
+    ->Arg(64)
+    ->Arg(1024);
+BENCHMARK_TEMPLATE(BM_serialize_round_trip, naive)
+    ->Arg(8)
+    ->Arg(64)
+    ->Arg(1024);
@@ -0,0 +1,111 @@
+/** Whole-storage SIMD kernels against loops over the elements.
+ *
+ * The vectors are static_vector<T, 64, stlpb::simd_policy> holding
+ * `state.range(0)` elements, sizes that are not multiples of the vector
+ * width. `simd` uses the kernels of static_vector_simd.hpp, which process all
+ * 64 slots and mask the ones past the size. `loop` is the usual loop over
+ * the elements, which needs a scalar tail and, at -O2 or for floating-point
+ * sums, is not vectorized at all.
+ * */
+
+#include "bench_common.hpp"
+
+#include <palotasb/static_vector_simd.hpp>
+
+#include <algorithm>
+#include <numeric>
+
+using stlpb::static_vector;
+
+namespace {
+
+constexpr std::size_t capacity = 64;
+
+template <typename T>
+using vector = static_vector<T, capacity, stlpb::simd_policy>;
+
+template <typename T> vector<T> make_vector(std::size_t size) {
+    vector<T> v;
+    for (std::size_t i = 0; i < size; ++i)
+        v.push_back(static_cast<T>(bench::make_value<int>{}(i) % 1000));
+    return v;
+}
+
+struct simd {};
+struct loop {};
+
+template <typename T> T sum(const vector<T>& v, simd) {
+    return stlpb::simd::sum(v);
+}
+template <typename T> T sum(const vector<T>& v, loop) {
+    return std::accumulate(v.begin(), v.end(), T(0));
+}
+
+int max(const vector<int>& v, simd) { return stlpb::simd::max(v); }
+int max(const vector<int>& v, loop) {
+    return *std::max_element(v.begin(), v.end());
+}
+
+std::size_t count_large(const vector<int>& v, simd) {
+    return stlpb::simd::count_if(v, [](int x) { return x > 500; });
+}
+std::size_t count_large(const vector<int>& v, loop) {
+    return static_cast<std::size_t>(
+        std::count_if(v.begin(), v.end(), [](int x) { return x > 500; }));
+}
+
+void scale(vector<float>& v, float factor, simd) {
+    stlpb::simd::transform(v, [factor](float x) { return x * factor; });
+}
+void scale(vector<float>& v, float factor, loop) {
+    for (float& x : v)
+        x *= factor;
+}
+
+template <typename T, typename Kernel>
+void BM_sum(benchmark::State& state) {
+    vector<T> v = make_vector<T>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&v);
+        benchmark::DoNotOptimize(sum(v, Kernel{}));
+    }
+}
+
+template <typename Kernel> void BM_max(benchmark::State& state) {
+    auto v = make_vector<int>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&v);
+        benchmark::DoNotOptimize(max(v, Kernel{}));
+    }
+}
+
+template <typename Kernel> void BM_count_if(benchmark::State& state) {
+    auto v = make_vector<int>(static_cast<std::size_t>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&v);
+        benchmark::DoNotOptimize(count_large(v, Kernel{}));
+    }
+}
+
+template <typename Kernel> void BM_scale(benchmark::State& state) {
+    auto v = make_vector<float>(static_cast<std::size_t>(state.range(0)));
+    float factor = 1.0f;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(factor);
+        scale(v, factor, Kernel{});
+        benchmark::DoNotOptimize(&v);
+    }
+}
+
+} // namespace
+
+BENCHMARK_TEMPLATE(BM_sum, int, loop)->Arg(13)->Arg(31)->Arg(61);
+BENCHMARK_TEMPLATE(BM_sum, int, simd)->Arg(13)->Arg(31)->Arg(61);
+BENCHMARK_TEMPLATE(BM_sum, float, loop)->Arg(13)->Arg(31)->Arg(61);
+BENCHMARK_TEMPLATE(BM_sum, float, simd)->Arg(13)->Arg(31)->Arg(61);
+BENCHMARK_TEMPLATE(BM_max, loop)->Arg(13)->Arg(31)->Arg(61);
+BENCHMARK_TEMPLATE(BM_max, simd)->Arg(13)->Arg(31)->Arg(61);
+BENCHMARK_TEMPLATE(BM_count_if, loop)->Arg(13)->Arg(31)->Arg(61);
+BENCHMARK_TEMPLATE(BM_count_if, simd)->Arg(13)->Arg(31)->Arg(61);
+BENCHMARK_TEMPLATE(BM_scale, loop)->Arg(13)->Arg(31)->Arg(61);
+BENCHMARK_TEMPLATE(BM_scale, simd)->Arg(13)->Arg(31)->Arg(61);
@@ -0,0 +1,98 @@
+/** Small capacities: straight-line code against the generic loops.
+ *
+ * static_vector<int, N> with N <= 8 inserts and erases single elements by
+ * shifting every slot with an unrolled loop and copies the whole element
+ * buffer, see stlpb::detail::is_unrolled. With N <= 4 it also compares and
+ * searches all slots without branching on the size. `Generic = true` runs the same operations
+ * through static_vector_ref<int>, std::find and the static_vector_ref
+ * comparison, which loop over the size or call memmove and memcmp. Capacities
+ * above 8 use the generic code either way.
+ * */
+
+#include "bench_common.hpp"
+
+using stlpb::static_vector;
+using stlpb::static_vector_ref;
+
+namespace {
+
+template <std::size_t N> static_vector<int, N> make_full() {
+    static_vector<int, N> v;
+    for (std::size_t i = 0; i < N; ++i)
+        v.push_back(static_cast<int>(i));
+    return v;
+}
+
+// Insert an element in the middle of an almost full vector and erase it
+template <std::size_t N, bool Generic>
+void BM_insert_erase(benchmark::State& state) {
+    static_vector<int, N> v = make_full<N>();
+    v.pop_back();
+    std::size_t index = v.size() / 2;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(index);
+        if (Generic) {
+            static_vector_ref<int>& ref = v;
+            ref.insert(ref.begin() + index, 42);
+            ref.erase(ref.begin() + index);
+        } else {
+            v.insert(v.begin() + index, 42);
+            v.erase(v.begin() + index);
+        }
+        benchmark::ClobberMemory();
+    }
+}
+
+// Look up every element and one missing value in turn
+template <std::size_t N, bool Generic> void BM_find(benchmark::State& state) {
+    const static_vector<int, N> v = make_full<N>();
+    int value = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            Generic ? std::find(v.begin(), v.end(), value) : v.find(value));
+        value = value == static_cast<int>(N) ? 0 : value + 1;
+    }
+}
+
+template <std::size_t N, bool Generic> void BM_copy(benchmark::State& state) {
+    const static_vector<int, N> v = make_full<N>();
+    static_vector<int, N> copy;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&v);
+        if (Generic)
+            static_cast<static_vector_ref<int>&>(copy) = v;
+        else
+            copy = v;
+        benchmark::DoNotOptimize(&copy);
+    }
+}
+
+template <std::size_t N, bool Generic> void BM_equal(benchmark::State& state) {
+    const static_vector<int, N> a = make_full<N>();
+    const static_vector<int, N> b = a;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(&a);
+        benchmark::DoNotOptimize(
+            Generic ? static_cast<const static_vector_ref<int>&>(a) == b
+                    : a == b);
+    }
+}
+
+} // namespace
+
+// Register `fn<N, false>` and `fn<N, true>` for capacities from 1 to 16
+#define BENCH_SMALL_CAPACITY(fn, n)                                            \
+    BENCHMARK_TEMPLATE(fn, n, false);                                          \
+    BENCHMARK_TEMPLATE(fn, n, true)
+#define BENCH_SMALL_CAPACITIES(fn)                                             \
+    BENCH_SMALL_CAPACITY(fn, 1);                                               \
+    BENCH_SMALL_CAPACITY(fn, 2);                                               \
+    BENCH_SMALL_CAPACITY(fn, 4);                                               \
+    BENCH_SMALL_CAPACITY(fn, 8);                                               \
+    BENCH_SMALL_CAPACITY(fn, 12);                                              \
+    BENCH_SMALL_CAPACITY(fn, 16)
+
+BENCH_SMALL_CAPACITIES(BM_insert_erase);
+BENCH_SMALL_CAPACITIES(BM_find);
+BENCH_SMALL_CAPACITIES(BM_copy);
+BENCH_SMALL_CAPACITIES(BM_equal);
@@ -0,0 +1,161 @@
+# Instruction-count regression check for static_vector operations.
+#
+# Runs every operation of the cachegrind_ops driver under valgrind's
+# cachegrind and compares the per-operation event counts against a checked-in
+# baseline. Cachegrind simulates the machine, so the counts are reproducible
+# for a given compiler and flags, unlike wall-clock timings on shared CI.
+#
+# Usage:
+#   cmake -DOPS_EXE=<cachegrind_ops> -DBASELINE=<file> [-DVALGRIND=valgrind]
+#         [-DTHRESHOLD=5] [-DITERATIONS=1000] [-DUPDATE_BASELINE=ON]
+#         [-DWORK_DIR=<dir>] -P cachegrind.cmake
+#
+# Each operation is run with ITERATIONS and 2 * ITERATIONS repetitions and the
+# difference is reported, i.e. the cost of ITERATIONS operations without
+# process startup and setup. Reported metrics:
+#   Ir           instructions executed
+#   L1_misses    I1 + D1 read and write misses
+#   LL_misses    last level cache read and write misses
+#   mispredicts  conditional and indirect branch mispredictions
+# A metric regresses when it exceeds the baseline by more than THRESHOLD
+# percent plus a slack of one event, so that zero baselines do not fail on a
+# single stray miss. Without any baseline counts for this build there is
+# nothing to compare, and the check prints "SKIPPED" instead of passing.
+
+cmake_minimum_required(VERSION 3.9)
+
+foreach(var OPS_EXE BASELINE)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "${var} must be defined")
+    endif()
+endforeach()
+if(NOT DEFINED VALGRIND)
+    set(VALGRIND valgrind)
+endif()
+if(NOT DEFINED THRESHOLD)
+    set(THRESHOLD 5)
+endif()
+if(NOT DEFINED ITERATIONS)
+    set(ITERATIONS 1000)
+endif()
+if(NOT DEFINED WORK_DIR)
+    get_filename_component(WORK_DIR "${OPS_EXE}" DIRECTORY)
+endif()
+
+set(metrics Ir L1_misses LL_misses mispredicts)
+
+# Run `op` for `iterations` under cachegrind and set `<prefix>_<metric>` in
+# the calling scope to the event totals of the whole process.
+function(cachegrind_run op iterations prefix)
+    set(out_file "${WORK_DIR}/cachegrind.out.${op}.${iterations}")
+    execute_process(
+        COMMAND "${VALGRIND}" --tool=cachegrind --cache-sim=yes
+                --branch-sim=yes "--cachegrind-out-file=${out_file}"
+                "${OPS_EXE}" ${op} ${iterations}
+        RESULT_VARIABLE result
+        OUTPUT_QUIET
+        ERROR_VARIABLE error)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "cachegrind failed for ${op}:\n${error}")
+    endif()
+
+    file(STRINGS "${out_file}" events_line REGEX "^events: ")
+    file(STRINGS "${out_file}" summary_line REGEX "^summary: ")
+    file(REMOVE "${out_file}")
+    string(REGEX REPLACE "^events: +" "" events_line "${events_line}")
+    string(REGEX REPLACE "^summary: +" "" summary_line "${summary_line}")
+    string(REGEX REPLACE " +" ";" events "${events_line}")
+    string(REGEX REPLACE " +" ";" counts "${summary_line}")
+
+    foreach(event Ir I1mr ILmr D1mr DLmr D1mw DLmw Bcm Bim)
+        set(${event} 0)
+    endforeach()
+    list(LENGTH events count)
+    math(EXPR last "${count} - 1")
+    foreach(i RANGE ${last})
+        list(GET events ${i} event)
+        list(GET counts ${i} value)
+        set(${event} ${value})
+    endforeach()
+
+    math(EXPR l1 "${I1mr} + ${D1mr} + ${D1mw}")
+    math(EXPR ll "${ILmr} + ${DLmr} + ${DLmw}")
+    math(EXPR bm "${Bcm} + ${Bim}")
+    set(${prefix}_Ir ${Ir} PARENT_SCOPE)
+    set(${prefix}_L1_misses ${l1} PARENT_SCOPE)
+    set(${prefix}_LL_misses ${ll} PARENT_SCOPE)
+    set(${prefix}_mispredicts ${bm} PARENT_SCOPE)
+endfunction()
+
+# Baseline file format: one line per operation, `<op> <Ir> <L1_misses>
+# <LL_misses> <mispredicts>`, counts for ITERATIONS operations. Lines
+# starting with `#` are comments.
+set(baseline_lines "")
+if(EXISTS "${BASELINE}")
+    file(STRINGS "${BASELINE}" baseline_lines REGEX "^[^#]")
+endif()
+foreach(line IN LISTS baseline_lines)
+    string(REGEX REPLACE " +" ";" fields "${line}")
+    list(GET fields 0 op)
+    set(i 1)
+    foreach(metric IN LISTS metrics)
+        list(GET fields ${i} baseline_${op}_${metric})
+        math(EXPR i "${i} + 1")
+    endforeach()
+endforeach()
+
+execute_process(
+    COMMAND "${OPS_EXE}" --list
+    OUTPUT_VARIABLE ops
+    RESULT_VARIABLE result)
+if(NOT result EQUAL 0)
+    message(FATAL_ERROR "${OPS_EXE} --list failed")
+endif()
+string(STRIP "${ops}" ops)
+string(REGEX REPLACE "\n" ";" ops "${ops}")
+
+math(EXPR double_iterations "2 * ${ITERATIONS}")
+set(report "")
+set(new_baseline
+    "# Cachegrind baseline for bench/cachegrind.cmake.\n"
+    "# Counts depend on the compiler and flags, regenerate with the\n"
+    "# cachegrind_baseline target after intentional changes.\n"
+    "# op Ir L1_misses LL_misses mispredicts (per ${ITERATIONS} operations)\n")
+string(CONCAT new_baseline ${new_baseline})
+set(regressions 0)
+set(compared 0)
+foreach(op IN LISTS ops)
+    cachegrind_run(${op} ${ITERATIONS} once)
+    cachegrind_run(${op} ${double_iterations} twice)
+    set(line "${op}")
+    foreach(metric IN LISTS metrics)
+        math(EXPR value "${twice_${metric}} - ${once_${metric}}")
+        set(line "${line} ${value}")
+        if(DEFINED baseline_${op}_${metric})
+            set(base ${baseline_${op}_${metric}})
+            math(EXPR compared "${compared} + 1")
+            math(EXPR limit "${base} + ${base} * ${THRESHOLD} / 100 + 1")
+            if(value GREATER limit)
+                math(EXPR regressions "${regressions} + 1")
+                string(APPEND report
+                    "REGRESSION ${op} ${metric}: ${value} > ${base} (+${THRESHOLD}%)\n")
+            else()
+                string(APPEND report "ok         ${op} ${metric}: ${value} (baseline ${base})\n")
+            endif()
+        else()
+            string(APPEND report "new        ${op} ${metric}: ${value} (no baseline)\n")
+        endif()
+    endforeach()
+    string(APPEND new_baseline "${line}\n")
+endforeach()
+
+message("${report}")
+if(UPDATE_BASELINE)
+    file(WRITE "${BASELINE}" "${new_baseline}")
+    message("Wrote baseline ${BASELINE}")
+elseif(regressions GREATER 0)
+    message(FATAL_ERROR "${regressions} cachegrind metric(s) regressed by more than ${THRESHOLD}%")
+elseif(compared EQUAL 0)
+    message("SKIPPED: no baseline counts in ${BASELINE}, generate them "
+            "with the cachegrind_baseline target")
+endif()
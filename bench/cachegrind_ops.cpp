@@ -0,0 +1,147 @@
+/** Driver for the instruction-count regression benchmarks.
+ *
+ * Usage: cachegrind_ops <operation> <iterations>
+ *
+ * Runs one static_vector operation `iterations` times. The program is meant
+ * to be run under valgrind's cachegrind by bench/cachegrind.cmake, which runs
+ * every operation twice with different iteration counts and subtracts the
+ * totals, so that process startup and setup cancel out and only the cost of
+ * the repeated operation remains.
+ * */
+
+#include <palotasb/static_vector.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+using stlpb::static_vector;
+
+namespace {
+
+// Keep the compiler from optimizing away work whose result is unused.
+template <typename T> inline void escape(T& value) {
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+#if defined(__GNUC__)
+#define CACHEGRIND_NOINLINE __attribute__((noinline))
+#else
+#define CACHEGRIND_NOINLINE
+#endif
+
+using int_vector = static_vector<int, 64>;
+using string_vector = static_vector<std::string, 16>;
+
+int_vector half_full() {
+    int_vector v;
+    for (int i = 0; i < 32; ++i)
+        v.push_back(i);
+    return v;
+}
+
+CACHEGRIND_NOINLINE void push_back(long iterations) {
+    for (long i = 0; i < iterations; ++i) {
+        int_vector v;
+        for (int j = 0; j < 64; ++j)
+            v.push_back(j);
+        escape(v);
+    }
+}
+
+CACHEGRIND_NOINLINE void insert_erase_front(long iterations) {
+    int_vector v = half_full();
+    for (long i = 0; i < iterations; ++i) {
+        v.insert(v.begin(), static_cast<int>(i));
+        escape(v);
+        v.erase(v.begin());
+        escape(v);
+    }
+}
+
+CACHEGRIND_NOINLINE void insert_erase_middle(long iterations) {
+    int_vector v = half_full();
+    for (long i = 0; i < iterations; ++i) {
+        v.insert(v.begin() + 16, static_cast<int>(i));
+        escape(v);
+        v.erase(v.begin() + 16);
+        escape(v);
+    }
+}
+
+CACHEGRIND_NOINLINE void copy(long iterations) {
+    int_vector v = half_full();
+    for (long i = 0; i < iterations; ++i) {
+        int_vector w(v);
+        escape(w);
+    }
+}
+
+CACHEGRIND_NOINLINE void iterate(long iterations) {
+    int_vector v = half_full();
+    for (long i = 0; i < iterations; ++i) {
+        escape(v);
+        long sum = 0;
+        for (int x : v)
+            sum += x;
+        escape(sum);
+    }
+}
+
+CACHEGRIND_NOINLINE void at(long iterations) {
+    int_vector v = half_full();
+    for (long i = 0; i < iterations; ++i) {
+        escape(v);
+        int x = v.at(static_cast<std::size_t>(i) % v.size());
+        escape(x);
+    }
+}
+
+CACHEGRIND_NOINLINE void string_push_back(long iterations) {
+    const std::string value = "short";
+    for (long i = 0; i < iterations; ++i) {
+        string_vector v;
+        for (int j = 0; j < 16; ++j)
+            v.push_back(value);
+        escape(v);
+    }
+}
+
+struct operation {
+    const char* name;
+    void (*run)(long iterations);
+};
+
+const operation operations[] = {
+    {"push_back", push_back},
+    {"insert_erase_front", insert_erase_front},
+    {"insert_erase_middle", insert_erase_middle},
+    {"copy", copy},
+    {"iterate", iterate},
+    {"at", at},
+    {"string_push_back", string_push_back},
+};
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc == 2 && std::strcmp(argv[1], "--list") == 0) {
+        for (const auto& op : operations)
+            std::printf("%s\n", op.name);
+        return 0;
+    }
+    if (argc != 3) {
+        std::fprintf(stderr, "usage: %s <operation> <iterations>\n", argv[0]);
+        std::fprintf(stderr, "       %s --list\n", argv[0]);
+        return 2;
+    }
+    for (const auto& op : operations) {
+        if (std::strcmp(argv[1], op.name) == 0) {
+            op.run(std::atol(argv[2]));
+            return 0;
+        }
+    }
+    std::fprintf(stderr, "unknown operation: %s\n", argv[1]);
+    return 2;
+}
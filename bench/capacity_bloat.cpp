@@ -0,0 +1,77 @@
+/** Code size of a program that uses static_vector with many capacities.
+ *
+ * Usage: capacity_bloat [iterations]
+ *
+ * The same message-handling work is done with static_vector<message, N> for
+ * 20 different capacities N. Before static_vector_ref, every capacity
+ * instantiated its own copy of insert, erase, push_back and the rest; now
+ * they are instantiated once for `message` and only the constructors,
+ * destructor and swap are per capacity. Compare the text size of this
+ * program (`size capacity_bloat`) and its instruction cache misses
+ * (`valgrind --tool=cachegrind --cache-sim=yes capacity_bloat`) between
+ * versions.
+ * */
+
+#include <palotasb/static_vector.hpp>
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+using stlpb::static_vector;
+
+namespace {
+
+struct message {
+    message(int i) : id(i), text("message body " + std::to_string(i)) {}
+    int id;
+    std::string text;
+};
+
+#if defined(__GNUC__)
+#define CAPACITY_BLOAT_NOINLINE __attribute__((noinline))
+#else
+#define CAPACITY_BLOAT_NOINLINE
+#endif
+
+// Fill, edit and drain a static_vector<message, N>
+template <std::size_t N> CAPACITY_BLOAT_NOINLINE long work(int seed) {
+    static_vector<message, N> v;
+    for (std::size_t i = 0; i < N / 2; ++i)
+        v.emplace_back(seed + static_cast<int>(i));
+    v.insert(v.begin() + v.size() / 2, message(seed));
+    v.emplace(v.begin(), seed + 1);
+    v.erase(v.begin() + 1);
+    v.unordered_erase(v.begin());
+    v.resize(v.size() + 1, message(seed + 2));
+    static_vector<message, N> copy(v);
+    v.assign(copy.begin(), copy.end() - 1);
+    copy.swap(v);
+    long sum = 0;
+    for (const auto& m : v)
+        sum += m.id + static_cast<long>(m.text.size());
+    while (!copy.empty())
+        copy.pop_back();
+    return sum;
+}
+
+template <std::size_t... Ns> long work_all(int seed) {
+    long sums[] = {work<Ns>(seed)...};
+    long sum = 0;
+    for (long s : sums)
+        sum += s;
+    return sum;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    long iterations = argc > 1 ? std::atol(argv[1]) : 1000;
+    long sum = 0;
+    for (long i = 0; i < iterations; ++i)
+        sum += work_all<
+            4, 6, 8, 10, 12, 14, 16, 20, 24, 28, 32, 40, 48, 56, 64, 80, 96,
+            112, 128, 160>(static_cast<int>(i));
+    std::printf("%ld\n", sum);
+    return 0;
+}
@@ -0,0 +1,342 @@
+#ifndef PALOTASB_MINIBENCH_H
+#define PALOTASB_MINIBENCH_H
+
+#pragma once
+
+/** Copyrighted according to the LICENSE file.
+ * SPDX-License-Identifier: MIT
+ * */
+
+/** Minimal stand-in for the subset of the Google Benchmark API used by the
+ * static_vector benchmarks. It is only used when Google Benchmark is not
+ * found at configure time, so the benchmark sources compile unchanged either
+ * way. Results are always written as Google Benchmark compatible JSON.
+ * */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace benchmark {
+
+struct runner;
+
+// User-defined counter, reported next to the timings.
+struct Counter {
+    enum Flags {
+        kDefaults = 0,
+        // Divide the value by the measured duration in seconds
+        kIsRate = 1,
+        // Divide the value by the number of iterations
+        kAvgIterations = 2,
+    };
+
+    Counter(double v = 0., int f = kDefaults) : value(v), flags(f) {}
+    Counter& operator=(double v) {
+        value = v;
+        return *this;
+    }
+
+    double value;
+    int flags;
+};
+
+// Unit of the reported times
+enum TimeUnit { kNanosecond, kMicrosecond, kMillisecond, kSecond };
+
+class State {
+public:
+    using clock = std::chrono::steady_clock;
+
+    State(std::int64_t max_iterations, std::vector<std::int64_t> args)
+        : m_max_iterations(max_iterations), m_args(std::move(args)) {}
+
+    struct StateIterator {
+        // Not trivial, so `for (auto _ : state)` does not warn that `_` is
+        // unused
+        struct Value {
+            ~Value() {}
+        };
+        State* state;
+        std::int64_t remaining;
+
+        Value operator*() const { return {}; }
+        StateIterator& operator++() {
+            --remaining;
+            return *this;
+        }
+        bool operator!=(const StateIterator&) {
+            if (remaining > 0)
+                return true;
+            state->finish_keep_running();
+            return false;
+        }
+    };
+
+    StateIterator begin() {
+        m_started = true;
+        m_start = clock::now();
+        return {this, m_max_iterations};
+    }
+    StateIterator end() { return {this, 0}; }
+
+    std::int64_t range(std::size_t index = 0) const { return m_args[index]; }
+    std::int64_t iterations() const { return m_max_iterations; }
+
+    void PauseTiming() { m_elapsed += clock::now() - m_start; }
+    void ResumeTiming() { m_start = clock::now(); }
+
+    void SetItemsProcessed(std::int64_t items) { m_items = items; }
+    void SetBytesProcessed(std::int64_t bytes) { m_bytes = bytes; }
+    void SetLabel(const std::string& label) { m_label = label; }
+    void SkipWithError(const char* message) {
+        m_error = message;
+        m_max_iterations = 0;
+    }
+
+    std::map<std::string, Counter> counters;
+
+private:
+    friend struct runner;
+
+    void finish_keep_running() { m_elapsed += clock::now() - m_start; }
+
+    std::int64_t m_max_iterations;
+    std::vector<std::int64_t> m_args;
+    bool m_started = false;
+    clock::time_point m_start;
+    clock::duration m_elapsed = clock::duration::zero();
+    std::int64_t m_items = 0;
+    std::int64_t m_bytes = 0;
+    std::string m_label;
+    std::string m_error;
+};
+
+namespace internal {
+
+using function = void (*)(State&);
+
+class Benchmark {
+public:
+    Benchmark(std::string name, function fn)
+        : m_name(std::move(name)), m_fn(fn) {}
+
+    Benchmark* Arg(std::int64_t arg) {
+        m_arg_sets.push_back({arg});
+        return this;
+    }
+    Benchmark* Args(std::vector<std::int64_t> args) {
+        m_arg_sets.push_back(std::move(args));
+        return this;
+    }
+    Benchmark* Unit(TimeUnit unit) {
+        m_unit = unit;
+        return this;
+    }
+
+private:
+    friend struct ::benchmark::runner;
+
+    std::string m_name;
+    function m_fn;
+    std::vector<std::vector<std::int64_t>> m_arg_sets;
+    TimeUnit m_unit = kNanosecond;
+};
+
+inline std::vector<std::unique_ptr<Benchmark>>& registry() {
+    static std::vector<std::unique_ptr<Benchmark>> benchmarks;
+    return benchmarks;
+}
+
+inline Benchmark* register_benchmark(const char* name, function fn) {
+    registry().emplace_back(new Benchmark(name, fn));
+    return registry().back().get();
+}
+
+} // namespace internal
+
+// Prevent the compiler from optimizing away `value` or computations feeding
+// into it. Same technique as Google Benchmark uses for GCC and Clang.
+template <typename T> inline void DoNotOptimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+template <typename T> inline void DoNotOptimize(T& value) {
+#if defined(__clang__)
+    asm volatile("" : "+r,m"(value) : : "memory");
+#else
+    asm volatile("" : "+m,r"(value) : : "memory");
+#endif
+}
+
+// Force all pending writes to memory.
+inline void ClobberMemory() { asm volatile("" : : : "memory"); }
+
+// Runs the registered benchmarks and prints Google Benchmark style JSON.
+struct runner {
+    double min_time = 0.2;
+    std::string filter;
+    std::FILE* out = stdout;
+
+    int run_all() {
+        std::fprintf(out, "{\n  \"context\": {\n");
+        std::fprintf(out, "    \"library_build_type\": \"minibench\"\n");
+        std::fprintf(out, "  },\n  \"benchmarks\": [");
+        bool first = true;
+        for (auto& bm : internal::registry()) {
+            auto arg_sets = bm->m_arg_sets;
+            if (arg_sets.empty())
+                arg_sets.emplace_back();
+            for (const auto& args : arg_sets) {
+                std::string name = bm->m_name;
+                for (auto arg : args)
+                    name += "/" + std::to_string(arg);
+                if (!filter.empty() && name.find(filter) == std::string::npos)
+                    continue;
+                run_one(name, bm->m_fn, args, bm->m_unit, first);
+                first = false;
+            }
+        }
+        std::fprintf(out, "\n  ]\n}\n");
+        return 0;
+    }
+
+private:
+    void run_one(
+        const std::string& name, internal::function fn,
+        const std::vector<std::int64_t>& args, TimeUnit unit, bool first) {
+        // Grow the iteration count until the run is long enough to be timed.
+        std::int64_t iterations = 1;
+        for (;;) {
+            State state(iterations, args);
+            fn(state);
+            double seconds =
+                std::chrono::duration<double>(state.m_elapsed).count();
+            bool done = !state.m_error.empty() || seconds >= min_time ||
+                        iterations >= (std::int64_t(1) << 40);
+            if (done) {
+                report(name, state, seconds, unit, first);
+                return;
+            }
+            double scale = seconds > 0 ? 1.4 * min_time / seconds : 10.;
+            if (scale > 10.)
+                scale = 10.;
+            if (scale < 2.)
+                scale = 2.;
+            iterations = static_cast<std::int64_t>(iterations * scale);
+        }
+    }
+
+    void report(
+        const std::string& name, const State& state, double seconds,
+        TimeUnit unit, bool first) {
+        static const char* const unit_names[] = {"ns", "us", "ms", "s"};
+        static const double unit_scales[] = {1e9, 1e6, 1e3, 1.};
+        auto iterations = state.m_max_iterations;
+        double time =
+            iterations ? seconds * unit_scales[unit] / iterations : 0.;
+        std::fprintf(out, "%s\n    {\n", first ? "" : ",");
+        std::fprintf(out, "      \"name\": \"%s\",\n", name.c_str());
+        std::fprintf(out, "      \"run_name\": \"%s\",\n", name.c_str());
+        std::fprintf(out, "      \"run_type\": \"iteration\",\n");
+        if (!state.m_error.empty()) {
+            std::fprintf(out, "      \"error_occurred\": true,\n");
+            std::fprintf(
+                out, "      \"error_message\": \"%s\",\n",
+                state.m_error.c_str());
+        }
+        if (!state.m_label.empty())
+            std::fprintf(
+                out, "      \"label\": \"%s\",\n", state.m_label.c_str());
+        std::fprintf(
+            out, "      \"iterations\": %lld,\n",
+            static_cast<long long>(iterations));
+        std::fprintf(out, "      \"real_time\": %.6g,\n", time);
+        std::fprintf(out, "      \"cpu_time\": %.6g,\n", time);
+        if (state.m_items && seconds > 0)
+            std::fprintf(
+                out, "      \"items_per_second\": %.6g,\n",
+                state.m_items / seconds);
+        if (state.m_bytes && seconds > 0)
+            std::fprintf(
+                out, "      \"bytes_per_second\": %.6g,\n",
+                state.m_bytes / seconds);
+        for (const auto& counter : state.counters) {
+            double value = counter.second.value;
+            if ((counter.second.flags & Counter::kIsRate) && seconds > 0)
+                value /= seconds;
+            if ((counter.second.flags & Counter::kAvgIterations) && iterations)
+                value /= iterations;
+            std::fprintf(
+                out, "      \"%s\": %.6g,\n", counter.first.c_str(), value);
+        }
+        std::fprintf(
+            out, "      \"time_unit\": \"%s\"\n    }", unit_names[unit]);
+        std::fflush(out);
+    }
+};
+
+// Understands the same flags as Google Benchmark for the common cases:
+// --benchmark_filter=<substring>, --benchmark_min_time=<seconds>,
+// --benchmark_out=<file>. The output format is always JSON.
+inline int run_main(int argc, char** argv) {
+    runner r;
+    std::string out_path;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        auto value = [&](const char* flag) -> const char* {
+            std::string prefix = std::string(flag) + "=";
+            return arg.compare(0, prefix.size(), prefix) == 0
+                       ? argv[i] + prefix.size()
+                       : nullptr;
+        };
+        if (auto v = value("--benchmark_filter"))
+            r.filter = v;
+        else if (auto v = value("--benchmark_min_time"))
+            r.min_time = std::atof(v);
+        else if (auto v = value("--benchmark_out"))
+            out_path = v;
+    }
+    if (!out_path.empty()) {
+        r.out = std::fopen(out_path.c_str(), "w");
+        if (!r.out) {
+            std::perror(out_path.c_str());
+            return 1;
+        }
+    }
+    int result = r.run_all();
+    if (r.out != stdout)
+        std::fclose(r.out);
+    return result;
+}
+
+} // namespace benchmark
+
+#define PALOTASB_MINIBENCH_CAT2(a, b) a##b
+#define PALOTASB_MINIBENCH_CAT(a, b) PALOTASB_MINIBENCH_CAT2(a, b)
+#define PALOTASB_MINIBENCH_UNIQUE(name)                                        \
+    PALOTASB_MINIBENCH_CAT(name, __COUNTER__)
+
+// The registration variables are never read
+#define BENCHMARK(fn)                                                          \
+    __attribute__((unused)) static ::benchmark::internal::Benchmark*           \
+        PALOTASB_MINIBENCH_UNIQUE(minibench_) =                                \
+            ::benchmark::internal::register_benchmark(#fn, fn)
+
+#define BENCHMARK_TEMPLATE(fn, ...)                                            \
+    __attribute__((unused)) static ::benchmark::internal::Benchmark*           \
+        PALOTASB_MINIBENCH_UNIQUE(minibench_) =                                \
+            ::benchmark::internal::register_benchmark(                         \
+                #fn "<" #__VA_ARGS__ ">", fn<__VA_ARGS__>)
+
+#define BENCHMARK_MAIN()                                                       \
+    int main(int argc, char** argv) {                                          \
+        return ::benchmark::run_main(argc, argv);                              \
+    }
+
+#endif // PALOTASB_MINIBENCH_H
@@ -0,0 +1,95 @@
+# FileCheck-style assertions on generated assembly.
+#
+# Usage: cmake -DSOURCE=<probes.cpp> -DASM=<probes.s> -P check_asm.cmake
+#
+# SOURCE contains comment directives:
+#   // CHECK-LABEL: <function>   start checking the body of <function>
+#   // CHECK: <regex>            must match a line after the previous CHECK
+#   // CHECK-NOT: <regex>        must not match any line of the body
+# A function body is every line between `<function>:` and `.size <function>`
+# in ASM. Regular expressions use CMake syntax; `\t` stands for a tab.
+
+cmake_minimum_required(VERSION 3.9)
+
+foreach(var SOURCE ASM)
+    if(NOT DEFINED ${var})
+        message(FATAL_ERROR "${var} must be defined")
+    endif()
+endforeach()
+
+# Collect function bodies into `body_<function>` lists.
+file(STRINGS "${ASM}" asm_lines)
+set(function "")
+foreach(line IN LISTS asm_lines)
+    if(function STREQUAL "")
+        if(line MATCHES "^([A-Za-z_][A-Za-z0-9_]*):$")
+            set(function "${CMAKE_MATCH_1}")
+            set(body_${function} "")
+        endif()
+    elseif(line MATCHES "^[ \t]*\\.size[ \t]+${function},")
+        set(function "")
+    else()
+        list(APPEND body_${function} "${line}")
+    endif()
+endforeach()
+
+# Returns in `out` the index of the first line of `function` at or after
+# `start` that matches `regex`, or -1.
+function(find_line function regex start out)
+    set(index 0)
+    foreach(line IN LISTS body_${function})
+        if(NOT index LESS start AND line MATCHES "${regex}")
+            set(${out} ${index} PARENT_SCOPE)
+            return()
+        endif()
+        math(EXPR index "${index} + 1")
+    endforeach()
+    set(${out} -1 PARENT_SCOPE)
+endfunction()
+
+file(STRINGS "${SOURCE}" directives REGEX "// CHECK(-LABEL|-NOT)?: ")
+set(failures 0)
+set(checks 0)
+set(function "")
+foreach(directive IN LISTS directives)
+    string(REGEX MATCH "// (CHECK(-LABEL|-NOT)?): (.*)$" _ "${directive}")
+    set(kind "${CMAKE_MATCH_1}")
+    string(STRIP "${CMAKE_MATCH_3}" pattern)
+    string(REPLACE "\\t" "\t" pattern "${pattern}")
+
+    if(kind STREQUAL "CHECK-LABEL")
+        set(function "${pattern}")
+        set(position 0)
+        if(NOT DEFINED body_${function})
+            message(SEND_ERROR "${function}: not found in ${ASM}")
+            math(EXPR failures "${failures} + 1")
+        endif()
+        continue()
+    endif()
+    if(function STREQUAL "")
+        message(FATAL_ERROR "${kind}: ${pattern} before any CHECK-LABEL")
+    endif()
+
+    math(EXPR checks "${checks} + 1")
+    if(kind STREQUAL "CHECK")
+        find_line(${function} "${pattern}" ${position} found)
+        if(found EQUAL -1)
+            message(SEND_ERROR "${function}: expected a match for `${pattern}`")
+            math(EXPR failures "${failures} + 1")
+        else()
+            math(EXPR position "${found} + 1")
+        endif()
+    else()
+        find_line(${function} "${pattern}" 0 found)
+        if(NOT found EQUAL -1)
+            list(GET body_${function} ${found} line)
+            message(SEND_ERROR "${function}: unexpected match for `${pattern}`: ${line}")
+            math(EXPR failures "${failures} + 1")
+        endif()
+    endif()
+endforeach()
+
+if(failures GREATER 0)
+    message(FATAL_ERROR "${failures} codegen check(s) failed in ${ASM}")
+endif()
+message("${checks} codegen checks passed in ${ASM}")
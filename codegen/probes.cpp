@@ -0,0 +1,171 @@
+/** Code generation probes, compiled with -O2 to assembly and checked by
+ * codegen/check_asm.cmake.
+ *
+ * Each probe is an `extern "C"` function so that its label in the assembly is
+ * its plain name. The comments before a probe describe what its assembly must
+ * (CHECK) or must not (CHECK-NOT) contain, as regular expressions matched
+ * against the lines between the function's label and its end. CHECK lines
+ * must match in order.
+ * */
+
+#include <palotasb/static_vector.hpp>
+#include <palotasb/static_vector_simd.hpp>
+
+#include <new>
+
+using stlpb::static_vector;
+
+extern "C" {
+
+// Unchecked element access is a single load.
+// CHECK-LABEL: probe_subscript
+// CHECK-NOT: call
+// CHECK-NOT: j[a-z]+[ \t]
+int probe_subscript(const static_vector<int, 16>& v, std::size_t i) {
+    return v[i];
+}
+
+// CHECK-LABEL: probe_size
+// CHECK-NOT: call
+// CHECK-NOT: j[a-z]+[ \t]
+std::size_t probe_size(const static_vector<int, 16>& v) { return v.size(); }
+
+// begin() and end() are plain pointer arithmetic on the object.
+// CHECK-LABEL: probe_begin_end
+// CHECK-NOT: call
+// CHECK-NOT: j[a-z]+[ \t]
+std::ptrdiff_t probe_begin_end(const static_vector<int, 16>& v) {
+    return v.end() - v.begin();
+}
+
+// CHECK-LABEL: probe_unchecked_push_back
+// CHECK-NOT: (__cxa_throw|throw_out_of_range)
+// CHECK-NOT: call
+void probe_unchecked_push_back(static_vector<int, 16>& v, int x) {
+    v.unchecked_push_back(x);
+}
+
+// A push_back guarded by full() lets the compiler drop the throwing path.
+// CHECK-LABEL: probe_guarded_push_back
+// CHECK-NOT: (__cxa_throw|throw_out_of_range)
+void probe_guarded_push_back(static_vector<int, 16>& v, int x) {
+    if (!v.full())
+        v.push_back(x);
+}
+
+// The checked push_back keeps its throwing path, through the shared
+// out-of-line exception helper.
+// CHECK-LABEL: probe_push_back
+// CHECK: (__cxa_throw|throw_out_of_range)
+void probe_push_back(static_vector<int, 16>& v, int x) { v.push_back(x); }
+
+// Removing the last trivially destructible element only decrements the size.
+// CHECK-LABEL: probe_pop_back
+// CHECK-NOT: call
+// CHECK-NOT: j[a-z]+[ \t]
+void probe_pop_back(static_vector<int, 16>& v) { v.pop_back(); }
+
+// Rolling back trivially destructible elements only sets the size.
+// CHECK-LABEL: probe_rollback
+// CHECK-NOT: call
+// CHECK-NOT: j[a-z]+[ \t]
+void probe_rollback(
+    static_vector<int, 16>& v,
+    static_vector<int, 16>::checkpoint_type mark) {
+    v.rollback(mark);
+}
+
+// emplace_back constructs in place; with a full() guard there is no throwing
+// path left.
+// CHECK-LABEL: probe_guarded_emplace_back
+// CHECK-NOT: (__cxa_throw|throw_out_of_range)
+int* probe_guarded_emplace_back(static_vector<int, 16>& v, int x) {
+    return v.full() ? nullptr : &v.emplace_back(x);
+}
+
+// Copying a vector of trivially copyable elements is a bulk memory copy, not
+// an element by element loop.
+// CHECK-LABEL: probe_copy_trivial
+// CHECK: (memcpy|memmove|rep movs)
+void probe_copy_trivial(
+    const static_vector<int, 64>& v, static_vector<int, 64>* out) {
+    new (out) static_vector<int, 64>(v);
+}
+
+// Equality of trivially comparable elements is a single memcmp (or bcmp,
+// which compilers use when only equality matters).
+// CHECK-LABEL: probe_equal
+// CHECK: (memcmp|bcmp)
+bool probe_equal(
+    const static_vector<int, 64>& a, const static_vector<int, 64>& b) {
+    return a == b;
+}
+
+// Small capacities of trivially copyable elements use straight-line code:
+// no loops, no calls to memcpy, memmove or memcmp and no branches on the size.
+// CHECK-LABEL: probe_small_find
+// CHECK-NOT: call
+// CHECK-NOT: j[a-z]+[ \t]
+const int* probe_small_find(const static_vector<int, 4>& v, int x) {
+    return v.find(x);
+}
+
+// CHECK-LABEL: probe_small_equal
+// CHECK-NOT: call
+// CHECK-NOT: j[a-z]+[ \t]
+bool probe_small_equal(
+    const static_vector<int, 4>& a, const static_vector<int, 4>& b) {
+    return a == b;
+}
+
+// CHECK-LABEL: probe_small_copy
+// CHECK-NOT: call
+// CHECK-NOT: j[a-z]+[ \t]
+void probe_small_copy(
+    const static_vector<int, 8>& v, static_vector<int, 8>* out) {
+    new (out) static_vector<int, 8>(v);
+}
+
+// CHECK-LABEL: probe_small_erase
+// CHECK-NOT: call
+// CHECK-NOT: j[a-z]+[ \t]
+void probe_small_erase(static_vector<int, 8>& v, std::size_t i) {
+    v.erase(v.begin() + i);
+}
+
+// concat returns a static_vector with the sum of the capacities, which has
+// room for both and needs no capacity check.
+// CHECK-LABEL: probe_concat
+// CHECK-NOT: (__cxa_throw|throw_out_of_range)
+void probe_concat(
+    const static_vector<int, 16>& a, const static_vector<int, 16>& b,
+    static_vector<int, 32>& out) {
+    new (&out) static_vector<int, 32>(stlpb::concat(a, b));
+}
+
+// The SIMD kernels vectorize at -O2, without a scalar tail loop, when the
+// storage is padded to whole registers. A loop over the elements only
+// vectorizes from -O3.
+// CHECK-LABEL: probe_simd_sum
+// CHECK: paddd
+// CHECK-NOT: addl
+int probe_simd_sum(const static_vector<int, 30, stlpb::simd_policy>& v) {
+    return stlpb::simd::sum(v);
+}
+
+// CHECK-LABEL: probe_simd_sum_float
+// CHECK: addps
+float probe_simd_sum_float(
+    const static_vector<float, 30, stlpb::simd_policy>& v) {
+    return stlpb::simd::sum(v);
+}
+
+// CHECK-LABEL: probe_simd_scale
+// CHECK: mulps
+// CHECK-NOT: mulss
+void probe_simd_scale(
+    static_vector<float, 30, stlpb::simd_policy>& v, float factor) {
+    stlpb::simd::transform(v, [factor](float x) { return x * factor; });
+}
+
+} // extern "C"
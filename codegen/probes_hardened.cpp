@@ -0,0 +1,51 @@
+/** Hardened mode probes, compiled with -O2 and
+ * PALOTASB_STATIC_VECTOR_HARDENED to assembly and checked by
+ * codegen/check_asm.cmake.
+ *
+ * A failed check is a trap instruction (ud2 on x86-64) at the end of the
+ * function, not a call, and the checked operations stay free of calls.
+ * */
+
+#include <palotasb/static_vector.hpp>
+
+using stlpb::static_vector;
+
+extern "C" {
+
+// CHECK-LABEL: probe_hardened_subscript
+// CHECK: ud2
+// CHECK-NOT: call
+int probe_hardened_subscript(const static_vector<int, 16>& v, std::size_t i) {
+    return v[i];
+}
+
+// CHECK-LABEL: probe_hardened_back
+// CHECK: ud2
+// CHECK-NOT: call
+int probe_hardened_back(const static_vector<int, 16>& v) { return v.back(); }
+
+// CHECK-LABEL: probe_hardened_pop_back
+// CHECK: ud2
+// CHECK-NOT: call
+void probe_hardened_pop_back(static_vector<int, 16>& v) { v.pop_back(); }
+
+// The position is checked before the elements are shifted.
+// CHECK-LABEL: probe_hardened_erase
+// CHECK: ud2
+int* probe_hardened_erase(static_vector<int, 16>& v, const int* pos) {
+    return v.erase(pos);
+}
+
+// A checked loop over the size does not need the checks: the compiler proves
+// them from the loop condition.
+// CHECK-LABEL: probe_hardened_loop
+// CHECK-NOT: ud2
+// CHECK-NOT: call
+int probe_hardened_loop(const static_vector<int, 16>& v) {
+    int sum = 0;
+    for (std::size_t i = 0; i < v.size(); ++i)
+        sum += v[i];
+    return sum;
+}
+
+} // extern "C"
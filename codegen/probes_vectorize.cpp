@@ -0,0 +1,33 @@
+/** Vectorization probes, compiled with -O3 to assembly and checked by
+ * codegen/check_asm.cmake. -O3 because GCC only vectorizes loops with an
+ * unknown trip count from -O3 (its -O2 cost model rejects them), and -O3 is
+ * what our performance-sensitive targets use.
+ *
+ * The checks are written for x86-64 SSE2, which every x86-64 compiler
+ * targets by default.
+ * */
+
+#include <palotasb/static_vector.hpp>
+
+using stlpb::static_vector;
+
+extern "C" {
+
+// Range-for over the elements is a contiguous loop that vectorizes.
+// CHECK-LABEL: probe_sum
+// CHECK: paddd
+int probe_sum(const static_vector<int, 64>& v) {
+    int sum = 0;
+    for (int x : v)
+        sum += x;
+    return sum;
+}
+
+// CHECK-LABEL: probe_scale
+// CHECK: mulps
+void probe_scale(static_vector<float, 64>& v, float factor) {
+    for (auto& x : v)
+        x *= factor;
+}
+
+} // extern "C"
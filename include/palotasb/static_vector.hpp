@@ -7,12 +7,57 @@
  * SPDX-License-Identifier: MIT
  * */
 
-#include <algorithm> // std::for_each, std::move*
-#include <array>     // std::array
-#include <exception> // std::out_of_range
-#include <iterator>  // std::reverse_iterator, std::distance
-#include <memory>    // std::uninitialized_*,
-#include <utility>   // std::aligned_storage
+#include <algorithm>   // std::for_each, std::move*
+#include <array>       // std::array
+#include <cstddef>     // offsetof
+#include <cstdint>     // std::uint64_t
+#include <cstring>     // std::memcpy, std::memmove, std::memcmp
+#include <functional>  // std::hash
+#include <iterator>    // std::reverse_iterator, std::distance
+#include <memory>      // std::uninitialized_*,
+#include <stdexcept>   // std::out_of_range
+#include <type_traits> // std::is_nothrow_*
+#include <utility>     // std::swap, std::pair, std::index_sequence
+
+#ifdef PALOTASB_STATIC_VECTOR_PROFILE
+#include <atomic>   // std::atomic
+#include <cstdio>   // std::fprintf
+#include <cstdlib>  // std::atexit, std::getenv
+#include <typeinfo> // typeid
+#if defined(__GNUG__)
+#include <cxxabi.h> // abi::__cxa_demangle
+#endif
+#endif
+
+#if __cplusplus >= 202002L
+#include <version> // __cpp_lib_ranges
+#if defined(__cpp_lib_ranges)
+#include <ranges> // std::ranges::*
+// C++20 range construction, append_range, insert_range and assign_range
+#define PALOTASB_STATIC_VECTOR_RANGES 1
+#endif
+#endif
+
+#ifdef PALOTASB_STATIC_VECTOR_HARDENED
+#include <cstdlib> // std::abort
+// Annotate the unused slots for AddressSanitizer in hardened builds with it
+#if defined(__SANITIZE_ADDRESS__)
+#define PALOTASB_STATIC_VECTOR_ANNOTATE 1
+#elif defined(__has_feature)
+#if __has_feature(address_sanitizer)
+#define PALOTASB_STATIC_VECTOR_ANNOTATE 1
+#endif
+#endif
+#endif
+
+#ifdef PALOTASB_STATIC_VECTOR_ANNOTATE
+// __sanitizer_annotate_contiguous_container
+#include <sanitizer/common_interface_defs.h>
+#define PALOTASB_STATIC_VECTOR_NO_SANITIZE_ADDRESS                            \
+    __attribute__((no_sanitize_address))
+#else
+#define PALOTASB_STATIC_VECTOR_NO_SANITIZE_ADDRESS
+#endif
 
 /** Static vector, a dynamic sized array storage that uses no automatic heap
  * memory allocation.
@@ -25,21 +70,573 @@
 
 namespace stlpb {
 
-// "PalotasB" Static Vector.
-// This class template behaves exactly like std::vector except that it
-// implements a fixed-size inline storage with the capacity defined by the
-// Capacity template parameter.
-// Main differences between static_vector and std::vector
-//  - static_vector does not have an Allocater template parameter as all
-// allocations are inline. (Its behaviour could be mostly implemented with a
-// specialized allocater type that only returns inline references.)
-//  - static_vector never reallocates and therefore iterators never become
-// invalid when the corresponding std::vector method might invalidate because of
-// reallocation.
-//  - `reserve(size_type)` and `shrink_to_fit()` are intentionally not
-// implemented because their existence would be misleading to the user.
-template <typename T, std::size_t Capacity> //
-struct static_vector {
+// Trait telling whether objects of type T can be relocated, i.e. moved to a
+// new address with the original's lifetime ended, by copying their bytes.
+// static_vector uses memmove instead of element-wise moves to shift such
+// elements in insert and erase. Defaults to trivially copyable types;
+// specialize it as std::true_type to opt in other types that do not point
+// into themselves or register their address anywhere, e.g. std::unique_ptr
+// or handle types.
+template <typename T>
+struct is_trivially_relocatable
+    : std::integral_constant<bool, std::is_trivially_copyable<T>::value> {};
+
+// Tag selecting default-initialization, which leaves trivial types such as
+// int uninitialized, instead of value-initialization in resize()
+struct default_init_t {};
+constexpr default_init_t default_init{};
+
+#ifdef PALOTASB_STATIC_VECTOR_RANGES
+// Tag selecting the range constructor, e.g.
+// `static_vector<int, 16> v(stlpb::from_range, view)`. The C++23 standard
+// library tag where it exists, so that std::ranges::to<static_vector<T, N>>
+// uses that constructor.
+#if defined(__cpp_lib_containers_ranges)
+using std::from_range_t;
+using std::from_range;
+#else
+struct from_range_t {
+    explicit from_range_t() = default;
+};
+inline constexpr from_range_t from_range{};
+#endif
+
+namespace detail {
+
+// A range whose elements can construct a T, the ranges accepted by the range
+// constructor and the *_range functions
+template <typename R, typename T>
+concept compatible_range =
+    std::ranges::input_range<R> &&
+    std::convertible_to<std::ranges::range_reference_t<R>, T>;
+
+} // namespace detail
+#endif
+
+namespace detail {
+
+// std::is_nothrow_swappable is C++17
+namespace swap_adl {
+using std::swap;
+template <typename T>
+struct is_nothrow_swappable
+    : std::integral_constant<
+          bool, noexcept(swap(std::declval<T&>(), std::declval<T&>()))> {};
+} // namespace swap_adl
+using swap_adl::is_nothrow_swappable;
+
+// Whether two objects of type T are equal exactly when their bytes are, so
+// that ranges of them can be compared and hashed with memcmp and bulk byte
+// hashing. Before C++17 only integral, enum and pointer types qualify.
+template <typename T>
+struct is_bitwise_comparable
+    : std::integral_constant<
+          bool,
+#if defined(__cpp_lib_has_unique_object_representations)
+          std::has_unique_object_representations<T>::value
+#else
+          std::is_integral<T>::value || std::is_enum<T>::value ||
+              std::is_pointer<T>::value
+#endif
+          > {
+};
+
+// Whether memcmp orders ranges of T the same way as
+// std::lexicographical_compare
+template <typename T>
+struct is_bytewise_ordered
+    : std::integral_constant<
+          bool, sizeof(T) == 1 && std::is_integral<T>::value &&
+                    std::is_unsigned<T>::value &&
+                    !std::is_same<T, bool>::value> {};
+
+// Exchange the `count` bytes at `a` and `b`, which do not overlap, eight at a
+// time through registers, without a buffer the size of the ranges
+inline void swap_bytes(void* a, void* b, std::size_t count) noexcept {
+    auto* x = static_cast<unsigned char*>(a);
+    auto* y = static_cast<unsigned char*>(b);
+    for (; count >= 8; x += 8, y += 8, count -= 8) {
+        std::uint64_t u, v;
+        std::memcpy(&u, x, 8);
+        std::memcpy(&v, y, 8);
+        std::memcpy(x, &v, 8);
+        std::memcpy(y, &u, 8);
+    }
+    for (; count != 0; ++x, ++y, --count)
+        std::swap(*x, *y);
+}
+
+// Hash `count` bytes eight at a time with a multiply-xorshift mix
+inline std::size_t hash_bytes(const void* data, std::size_t count) noexcept {
+    const std::uint64_t multiplier = 0x9e3779b97f4a7c15ull;
+    const auto* bytes = static_cast<const unsigned char*>(data);
+    std::uint64_t hash = count * multiplier;
+    auto mix = [&](std::uint64_t word) {
+        hash = (hash ^ word) * multiplier;
+        hash ^= hash >> 32;
+    };
+    for (; count >= 8; bytes += 8, count -= 8) {
+        std::uint64_t word;
+        std::memcpy(&word, bytes, 8);
+        mix(word);
+    }
+    if (count > 0) {
+        std::uint64_t word = 0;
+        std::memcpy(&word, bytes, count);
+        mix(word);
+    }
+    return static_cast<std::size_t>(hash);
+}
+
+// Whether two ranges of `size` elements are equal, with a single memcmp for
+// bitwise comparable T
+template <typename T>
+bool equal_n(const T* a, const T* b, std::size_t size) {
+    if (is_bitwise_comparable<T>::value)
+        return size == 0 || std::memcmp(
+                                static_cast<const void*>(a),
+                                static_cast<const void*>(b),
+                                size * sizeof(T)) == 0;
+    return std::equal(a, a + size, b);
+}
+
+// Whether static_vector<T, Capacity> uses straight-line code for its small
+// capacity: the elements are trivially copyable and all of them fit in a 64
+// byte cache line. Copies then copy the whole element buffer, and inserting
+// or erasing one element shifts every slot with an unrolled loop instead of
+// a memmove of the size-dependent tail. Never in builds that annotate the
+// unused slots for AddressSanitizer, which must not be read.
+#ifdef PALOTASB_STATIC_VECTOR_ANNOTATE
+template <typename T, std::size_t Capacity>
+struct is_unrolled : std::false_type {};
+#else
+template <typename T, std::size_t Capacity>
+struct is_unrolled
+    : std::integral_constant<
+          bool, 0 < Capacity && Capacity <= 8 && Capacity * sizeof(T) <= 64 &&
+                    std::is_trivially_copyable<T>::value> {};
+#endif
+
+// Whether find and == of static_vector<T, Capacity> read all slots with
+// straight-line code. Slots past the size are read too, which requires that
+// any bytes they hold are a valid T: the storage is zero-initialized and a
+// bitwise comparable T has no padding or invalid values. Only up to 4 slots:
+// from 8 on, the early-exit loop and memcmp are as fast or faster.
+template <typename T, std::size_t Capacity>
+struct is_unrolled_comparable
+    : std::integral_constant<
+          bool, is_unrolled<T, Capacity>::value && Capacity <= 4 &&
+                    is_bitwise_comparable<T>::value> {};
+
+// Call `f(I)` for each I in order, without a loop
+template <typename F, std::size_t... I>
+void unroll(F f, std::index_sequence<I...>) {
+    // The elements of a braced list are evaluated from left to right
+    int expand[] = {0, (f(I), 0)...};
+    (void)expand;
+    (void)f;
+}
+
+// Bit `Slot` set for each of the slots at `a` for which
+// `predicate(a[Slot], Slot)` holds, without branches. The bits are
+// independent, so the comparisons do not form a dependency chain.
+template <typename T, typename Predicate, std::size_t... Slot>
+unsigned
+slot_mask(const T* a, Predicate predicate, std::index_sequence<Slot...>) {
+    unsigned mask = 0;
+    int expand[] = {
+        0, (mask |= unsigned(predicate(a[Slot], Slot)) << Slot, 0)...};
+    (void)expand;
+    return mask;
+}
+
+// Bits [0, size) set
+inline unsigned low_bits(std::size_t size) noexcept {
+    return (1u << size) - 1;
+}
+
+// The index of the lowest set bit of a nonzero `mask`
+inline std::size_t lowest_bit(unsigned mask) noexcept {
+#if defined(__GNUC__)
+    return static_cast<std::size_t>(__builtin_ctz(mask));
+#else
+    std::size_t index = 0;
+    for (; !(mask & 1u); mask >>= 1)
+        ++index;
+    return index;
+#endif
+}
+
+// Whether the ranges of `a_size` and `b_size` elements in the `Capacity`
+// slots at `a` and `b` are equal. The unrolled version compares every slot
+// and masks the result with the size.
+template <std::size_t Capacity, typename T>
+bool equal_slots(
+    const T* a, std::size_t a_size, const T* b, std::size_t b_size,
+    std::true_type) noexcept {
+    unsigned differ = slot_mask(
+        a, [b](const T& x, std::size_t slot) { return x != b[slot]; },
+        std::make_index_sequence<Capacity>{});
+    return (a_size == b_size) & ((differ & low_bits(a_size)) == 0);
+}
+template <std::size_t Capacity, typename T>
+bool equal_slots(
+    const T* a, std::size_t a_size, const T* b, std::size_t b_size,
+    std::false_type) {
+    return a_size == b_size && equal_n(a, b, a_size);
+}
+
+// The iterator category tag of Iter, to dispatch on
+template <typename Iter>
+using iterator_category_t =
+    typename std::iterator_traits<Iter>::iterator_category;
+
+// Storage for one element with the size and alignment of T
+template <typename T>
+using storage_type = std::aligned_storage_t<sizeof(T), alignof(T)>;
+
+// Statistics of a static_vector type in PALOTASB_STATIC_VECTOR_PROFILE builds
+struct profile_stats;
+// Functions of a Policy::observer in PALOTASB_STATIC_VECTOR_OBSERVE builds
+struct observer_hooks;
+
+// The layout of static_vector<T, Capacity> up to its first element: the data
+// members of static_vector_ref<T> followed by the element storage, like
+// LLVM's SmallVectorAlignmentAndSize. static_vector itself is not standard
+// layout, so offsetof cannot be used on it, but its base and first member are
+// laid out the same way as this struct's members.
+template <typename T> struct static_vector_layout {
+    std::size_t size;
+    std::size_t capacity;
+#ifdef PALOTASB_STATIC_VECTOR_PROFILE
+    profile_stats* stats;
+    std::size_t peak;
+#endif
+#ifdef PALOTASB_STATIC_VECTOR_OBSERVE
+    const observer_hooks* observer;
+    std::size_t observed_size;
+#endif
+#ifdef PALOTASB_STATIC_VECTOR_ANNOTATE
+    std::size_t annotated_size;
+#endif
+    storage_type<T> first;
+
+    // Offset of the first element from the start of a static_vector
+    static constexpr std::size_t offset() noexcept {
+        return offsetof(static_vector_layout, first);
+    }
+};
+
+// A standard layout stand-in for static_vector with the `Elements` array
+// `m_data` and alignment `Alignment`: bytes in place of the base subobject
+// followed by the array, so offsetof can find where static_vector puts it
+template <typename Base, typename Elements, std::size_t Alignment>
+struct alignas(Alignment) static_vector_mirror {
+    alignas(Base) unsigned char base[sizeof(Base)];
+    Elements elements;
+};
+
+// The largest of the given alignments
+constexpr std::size_t max_alignment(std::size_t a, std::size_t b) noexcept {
+    return a < b ? b : a;
+}
+constexpr std::size_t
+max_alignment(std::size_t a, std::size_t b, std::size_t c) noexcept {
+    return max_alignment(max_alignment(a, b), c);
+}
+
+// The number of element slots for `capacity` elements of `element_size`
+// bytes with the storage padded to a multiple of `width` bytes. Only padded
+// if a `width` byte register holds more than one element.
+constexpr std::size_t padded_capacity(
+    std::size_t capacity, std::size_t element_size,
+    std::size_t width) noexcept {
+    return width / element_size < 2
+               ? capacity
+               : (capacity + width / element_size - 1) /
+                     (width / element_size) * (width / element_size);
+}
+
+// Reasons for throwing std::out_of_range, in the order of their messages
+enum class out_of_range_error { index, size, count, distance };
+
+// Throw std::out_of_range without allocating its message on every throw.
+// The exceptions are constructed once and copies of them are thrown. The
+// standard library exception types share their message string between
+// copies, so only the exception object itself is allocated by the C++
+// runtime when throwing.
+[[noreturn]] inline void throw_out_of_range(out_of_range_error error) {
+    static const std::out_of_range errors[] = {
+        std::out_of_range("index"), std::out_of_range("size()"),
+        std::out_of_range("count"),
+        std::out_of_range("std::distance(begin, end)")};
+    throw errors[static_cast<int>(error)];
+}
+
+// Stop the program unless `precondition` holds, in
+// PALOTASB_STATIC_VECTOR_HARDENED builds. Hardened builds check the
+// preconditions of the functions that do not check them otherwise:
+// operator[], front(), back(), pop_back(), the unchecked_* functions,
+// rollback() and the positions passed to insert, emplace and erase. A
+// violated precondition is a bug, not an error to recover from like the
+// ones at() throws for, so the check executes a trap instruction instead of
+// throwing. The branch is marked unlikely, so it costs a compare and a
+// predicted jump to cold code, and none in loops whose condition proves it.
+// Without the macro the checks compile to nothing.
+#ifdef PALOTASB_STATIC_VECTOR_HARDENED
+inline void check_precondition(bool precondition) noexcept {
+#if defined(__GNUC__)
+    if (__builtin_expect(!precondition, 0))
+        __builtin_trap();
+#else
+    if (!precondition)
+        std::abort();
+#endif
+}
+#else
+inline void check_precondition(bool) noexcept {}
+#endif
+
+#ifdef PALOTASB_STATIC_VECTOR_PROFILE
+
+// High-water-mark profiling, enabled by defining
+// PALOTASB_STATIC_VECTOR_PROFILE. Every static_vector instantiation records
+// the peak size reached by each of its objects, a histogram of those peaks
+// and the number of overflow attempts. A report with recommended capacities
+// is written at exit to stderr or to the file named by the
+// PALOTASB_STATIC_VECTOR_PROFILE_OUTPUT environment variable. Objects still
+// alive at exit are not included in the report.
+//
+// Without the macro none of this is compiled and static_vector has no
+// profiling members.
+struct profile_stats {
+    // Histogram bucket 0 counts peak size 0, bucket k counts peak sizes in
+    // [2^(k-1), 2^k).
+    static const int buckets = 8 * sizeof(std::size_t) + 1;
+
+    const std::type_info& type;
+    std::size_t capacity;
+    std::atomic<std::size_t> objects;
+    std::atomic<std::size_t> max_size;
+    std::atomic<std::size_t> overflows;
+    std::atomic<std::size_t> histogram[buckets];
+    profile_stats* next;
+
+    profile_stats(const std::type_info& t, std::size_t c) noexcept
+        : type(t), capacity(c), objects(0), max_size(0), overflows(0) {
+        for (auto& count : histogram)
+            count.store(0, std::memory_order_relaxed);
+        register_stats(this);
+    }
+
+    // Record the peak size of an object at the end of its lifetime
+    void record_peak(std::size_t peak) noexcept {
+        objects.fetch_add(1, std::memory_order_relaxed);
+        histogram[bucket(peak)].fetch_add(1, std::memory_order_relaxed);
+        auto max = max_size.load(std::memory_order_relaxed);
+        while (max < peak && !max_size.compare_exchange_weak(
+                                 max, peak, std::memory_order_relaxed)) {
+        }
+    }
+
+    void record_overflow() noexcept {
+        overflows.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static int bucket(std::size_t size) noexcept {
+        int k = 0;
+        while (size) {
+            size >>= 1;
+            ++k;
+        }
+        return k;
+    }
+
+    // Smallest size that at least `fraction` of the objects did not exceed,
+    // rounded up to the histogram bucket boundary but at most the max size
+    std::size_t percentile(double fraction) const noexcept {
+        auto total = objects.load(std::memory_order_relaxed);
+        auto max = max_size.load(std::memory_order_relaxed);
+        std::size_t seen = 0;
+        for (int k = 0; k < buckets; ++k) {
+            seen += histogram[k].load(std::memory_order_relaxed);
+            if (seen >= fraction * total) {
+                auto upper = k == 0 ? 0 : (std::size_t(1) << (k - 1)) * 2 - 1;
+                return upper < max ? upper : max;
+            }
+        }
+        return max;
+    }
+
+    static std::atomic<profile_stats*>& head() noexcept {
+        static std::atomic<profile_stats*> list(nullptr);
+        return list;
+    }
+
+    static void register_stats(profile_stats* stats) noexcept {
+        // Registered once, even if several threads register their first
+        // stats at the same time
+        static const bool registered = (std::atexit(report), true);
+        (void)registered;
+        auto& list = head();
+        auto first = list.load();
+        do
+            stats->next = first;
+        while (!list.compare_exchange_weak(first, stats));
+    }
+
+    static void report() {
+        std::FILE* out = stderr;
+        if (const char* path =
+                std::getenv("PALOTASB_STATIC_VECTOR_PROFILE_OUTPUT"))
+            if (std::FILE* file = std::fopen(path, "w"))
+                out = file;
+        std::fprintf(out, "static_vector profile\n");
+        for (auto stats = head().load(); stats; stats = stats->next)
+            stats->print(out);
+        if (out != stderr)
+            std::fclose(out);
+    }
+
+    void print(std::FILE* out) const {
+        const char* name = type.name();
+#if defined(__GNUG__)
+        int status = 0;
+        char* demangled = abi::__cxa_demangle(name, nullptr, nullptr, &status);
+        if (status == 0)
+            name = demangled;
+#endif
+        auto max = max_size.load();
+        auto overflow_count = overflows.load();
+        std::fprintf(
+            out,
+            "%s\n  capacity %zu, objects %zu, max size %zu, p50 <= %zu, "
+            "p90 <= %zu, p99 <= %zu, overflows %zu\n",
+            name, capacity, objects.load(), max, percentile(0.5),
+            percentile(0.9), percentile(0.99), overflow_count);
+        std::fprintf(out, "  peak size histogram:");
+        for (int k = 0; k < buckets; ++k)
+            if (auto count = histogram[k].load())
+                std::fprintf(
+                    out, " [%zu, %zu]: %zu",
+                    k == 0 ? 0 : std::size_t(1) << (k - 1),
+                    k == 0 ? 0 : (std::size_t(1) << (k - 1)) * 2 - 1, count);
+        if (overflow_count)
+            std::fprintf(
+                out, "\n  recommended capacity: more than %zu (overflowed)\n",
+                capacity);
+        else
+            std::fprintf(out, "\n  recommended capacity: %zu\n", max);
+#if defined(__GNUG__)
+        if (status == 0)
+            std::free(demangled);
+#endif
+    }
+};
+
+#endif // PALOTASB_STATIC_VECTOR_PROFILE
+
+} // namespace detail
+
+// Observer of the operations of static_vector, the `observer` member type of
+// the Policy, e.g. for counting overflows or tracing in production. Derive
+// from it and hide the functions to observe:
+//   struct my_observer : stlpb::null_observer {
+//       static void overflow(std::size_t capacity) noexcept { ... }
+//   };
+// The functions are only called if PALOTASB_STATIC_VECTOR_OBSERVE is
+// defined, which adds a pointer and a size to every static_vector_ref, and
+// they must not throw. Without the macro a Policy with an observer does not
+// compile, and no static_vector has any observer code or data.
+// See static_vector_observers.hpp for ready-made observers.
+struct null_observer {
+    // A static_vector of `capacity` was constructed
+    static void construct(std::size_t /*capacity*/) noexcept {}
+    // The size grew to `size`
+    static void grow(std::size_t /*size*/, std::size_t /*capacity*/) noexcept {
+    }
+    // The size shrank to `size`
+    static void
+    shrink(std::size_t /*size*/, std::size_t /*capacity*/) noexcept {}
+    // `count` elements were moved to open or close a gap for insert or erase
+    static void shift(std::size_t /*count*/) noexcept {}
+    // An operation would have exceeded the capacity and throws
+    static void overflow(std::size_t /*capacity*/) noexcept {}
+};
+
+namespace detail {
+
+// The functions of an observer, so that static_vector_ref can call them
+// without knowing the Policy
+struct observer_hooks {
+    void (*construct)(std::size_t capacity);
+    void (*grow)(std::size_t size, std::size_t capacity);
+    void (*shrink)(std::size_t size, std::size_t capacity);
+    void (*shift)(std::size_t count);
+    void (*overflow)(std::size_t capacity);
+};
+
+// The hooks of `Observer`, null for null_observer so that unobserved
+// static_vectors only test a pointer
+template <typename Observer>
+const observer_hooks* observer_hooks_of() noexcept {
+    static const observer_hooks hooks = {
+        &Observer::construct, &Observer::grow, &Observer::shrink,
+        &Observer::shift, &Observer::overflow};
+    return &hooks;
+}
+template <>
+inline const observer_hooks* observer_hooks_of<null_observer>() noexcept {
+    return nullptr;
+}
+
+} // namespace detail
+
+// Policy of static_vector, the optional third template parameter. Derive
+// from it and hide the members to change them, e.g.
+//   struct my_policy : stlpb::static_vector_policy {
+//       static constexpr std::size_t alignment = 64;
+//   };
+struct static_vector_policy {
+    // Alignment of static_vector objects in bytes. The natural alignment of
+    // the size fields and the elements is used if it is larger, so 0 means
+    // no extra alignment. Aligning to the cache line size (64 on x86-64)
+    // keeps static_vectors in an array, e.g. one per thread, from sharing
+    // cache lines, and puts the size on the same line as the first elements.
+    static constexpr std::size_t alignment = 0;
+    // SIMD register size in bytes that the element storage is padded to a
+    // multiple of, see static_vector::padded_capacity. 0 means no padding.
+    // The slots past the capacity never hold elements, but the whole-storage
+    // kernels of static_vector_simd.hpp read and write them to avoid scalar
+    // tail loops.
+    static constexpr std::size_t simd_width = 0;
+    // Observer of the operations, see null_observer
+    using observer = null_observer;
+};
+
+// Policy aligning static_vectors to 64 byte cache lines
+struct cache_aligned_policy : static_vector_policy {
+    static constexpr std::size_t alignment = 64;
+};
+
+// Policy padding the element storage to whole 32 byte (AVX) registers, which
+// also covers 16 byte (SSE, NEON) registers
+struct simd_policy : static_vector_policy {
+    static constexpr std::size_t simd_width = 32;
+};
+
+// Capacity-independent part of static_vector<T, Capacity>, in the style of
+// LLVM's SmallVectorImpl. It has the whole interface of static_vector except
+// construction, destruction and swap, and it stores the capacity as a member
+// instead of a template parameter. The member functions are therefore
+// instantiated once per element type instead of once per capacity, and
+// functions can take a `static_vector_ref<T>&` to work with static_vectors of
+// any capacity.
+// A static_vector_ref is always the base of a static_vector, it cannot be
+// constructed on its own. The elements are found at a fixed offset from the
+// start of the object, see detail::static_vector_layout.
+template <typename T> //
+struct static_vector_ref {
 
     // MEMBER TYPES
 
@@ -61,104 +658,88 @@ struct static_vector {
     // Reverse iterator is what the STL provides for reverse iterating pointers
     using reverse_iterator = std::reverse_iterator<iterator>;
     using const_reverse_iterator = std::reverse_iterator<const_iterator>;
-    // The static capacity of the static_vector
-    static const size_type static_capacity = Capacity;
-
-    // CONSTRUCTORS
-
-    // Default constructor
-    // Requires: nothing
-    // Ensures: The static_vector contains zero elements.
-    // Complexity: constant
-    // Exceptions: noexcept
-    static_vector() noexcept : m_size(0) {}
-
-    // "N copies of one value" constructor
-    // Requires:
-    //  `count` is less than or equal to `capacity`
-    // Ensures:
-    //  The static_vector contains `count` elements copy-constructed from
-    //  `value`.
-    // Complexity: O(count)
-    // Exceptions: noexcept iff the copy constructor of value_type is noexcept
-    static_vector(size_type count, const_reference value) //
-        noexcept(noexcept(value_type(value)))
-        : m_size(count) {
-        std::uninitialized_fill(begin(), end(), value);
-    }
-
-    // "N default constructed items" constructor
-    static_vector(size_type count) noexcept(noexcept(value_type{}))
-        : m_size(count) {
-        std::for_each( // C++17 would use std::uninitialized_default_construct
-            storage_begin(), storage_end(), [](storage_type& store) {
-                new (static_cast<void*>(&store)) value_type;
-            });
-    }
-
-    // Initializer list constructor
-    static_vector(std::initializer_list<value_type> init_list)
-        : m_size(init_list.end() - init_list.begin()) {
-        std::uninitialized_copy(init_list.begin(), init_list.end(), begin());
-    }
-
-    // TODO maybe implement trivial copy/move/destruct if `value_type` supports
-    // it
+    // The size at a point in time, returned by checkpoint(), see rollback()
+    struct checkpoint_type {
+        size_type size;
+    };
+    class checkpoint_guard;
 
-    // Copy constructor
-    static_vector(const static_vector& other) : m_size(other.m_size) {
-        std::uninitialized_copy(other.begin(), other.end(), begin());
+    // Assign the elements of a static_vector of any capacity
+    // Exceptions: std::out_of_range if `other.size()` is greater than
+    // `capacity()`, and the exceptions of the copy constructor and assignment
+    // of value_type.
+    static_vector_ref& operator=(const static_vector_ref& other) {
+        if (&other != this)
+            assign(other.begin(), other.end());
+        return *this;
     }
-
-    // Copy assignment
-    static_vector& operator=(const static_vector& other) {
+    // Move the elements of a static_vector of any capacity
+    // Exceptions: std::out_of_range if `other.size()` is greater than
+    // `capacity()`, and the exceptions of the move constructor and assignment
+    // of value_type.
+    static_vector_ref& operator=(static_vector_ref&& other) {
         if (&other == this)
             return *this;
-        clear();
-        m_size = other.m_size;
-        std::uninitialized_copy(other.begin(), other.end(), begin());
+        if (m_capacity < other.m_size)
+            throw_out_of_range(detail::out_of_range_error::size);
+        assign_n(std::make_move_iterator(other.begin()), other.m_size);
         return *this;
     }
 
-    // Move constructor
-    static_vector(static_vector&& other) : m_size(other.m_size) {
-        std::uninitialized_copy(
-            std::make_move_iterator(other.begin()),
-            std::make_move_iterator(other.end()), //
-            begin());
+    // Initializer list assignment
+    static_vector_ref& operator=(std::initializer_list<value_type> init_list) {
+        assign(init_list);
+        return *this;
     }
 
-    // Move assignment
-    static_vector& operator=(static_vector&& other) {
-        if (&other == this)
-            return *this;
-        clear();
-        m_size = other.m_size;
-        std::uninitialized_copy(
-            std::make_move_iterator(other.begin()),
-            std::make_move_iterator(other.end()), begin());
-        return *this;
+    // Assignment reuses existing elements: the first min(size(), count)
+    // elements are assigned to, the rest are copy constructed or destroyed.
+    // Elements owning resources, such as the heap buffer of a std::string,
+    // keep them when they are assigned to. This applies to the copy and move
+    // assignment operators too.
+
+    // Replace the contents with `count` copies of `value`
+    // Requires: `value` is not a reference to an element of the static_vector
+    // Complexity: O(max(size(), count))
+    // Exceptions: std::out_of_range if `count` is greater than `capacity()`,
+    // and the exceptions of the copy constructor and assignment of value_type.
+    void assign(size_type count, const value_type& value) {
+        if (m_capacity < count)
+            throw_out_of_range(detail::out_of_range_error::count);
+        size_type common = std::min(count, m_size);
+        std::fill_n(begin(), common, value);
+        if (count <= m_size) {
+            destroy(begin() + count, end());
+        } else {
+            annotate_size(count);
+            annotation_guard guard{this};
+            std::uninitialized_fill_n(end(), count - common, value);
+            guard.vector = nullptr;
+        }
+        m_size = count;
+        size_changed();
     }
 
-    // Iterator constructor with basic SFINAE mechanism to cancel use with
-    // non-iterator types
+    // Replace the contents with the elements of [input_begin, input_end).
+    // Single-pass input iterators, e.g. std::istream_iterator, are read once
+    // and the capacity is checked per element.
+    // Requires: the range does not refer to elements of the static_vector
+    // Complexity: O(max(size(), std::distance(input_begin, input_end)))
+    // Exceptions: std::out_of_range if the range is longer than `capacity()`,
+    // before any change unless the iterators are input iterators, and the
+    // exceptions of the copy constructor and assignment of value_type.
     template <
         typename Iter, typename = decltype(*std::declval<Iter&>()),
         typename = decltype(++std::declval<Iter&>())>
-    static_vector(Iter input_begin, Iter input_end) {
-        m_size = std::distance(input_begin, input_end);
-        std::uninitialized_copy(input_begin, input_end, begin());
+    void assign(Iter input_begin, Iter input_end) {
+        assign_elements(
+            input_begin, input_end, detail::iterator_category_t<Iter>{});
     }
 
-    // Destructor
-    // Ensures: all objects are destructed properly, but trivial destructors are
-    // not run.
-    // Complexity: O(size()) for non-trivially destructible value_type,
-    // otherwise constant.
-    ~static_vector() { clear(); }
-
-    // FIXME the equivalent to std::vector::assign functions can be implemented
-    // the same way as the corresponding ctors
+    // Replace the contents with the elements of `init_list`
+    void assign(std::initializer_list<value_type> init_list) {
+        assign(init_list.begin(), init_list.end());
+    }
 
     // ELEMENT ACCESS
 
@@ -173,40 +754,62 @@ struct static_vector {
         if (index < m_size)
             return data(index);
         else
-            throw std::out_of_range("index");
+            detail::throw_out_of_range(detail::out_of_range_error::index);
     }
     const_reference at(size_type index) const {
         if (index < m_size)
             return data(index);
         else
-            throw std::out_of_range("index");
+            detail::throw_out_of_range(detail::out_of_range_error::index);
     }
 
-    // Element access with bounds checking
+    // Element access without bounds checking, except in hardened builds, see
+    // detail::check_precondition
     // Requires: index is less than size
     // Returns: the element at `index`
     // Complexity: constant
     // Exceptions: noexcept
-    reference operator[](size_t index) noexcept { return data(index); }
+    reference operator[](size_t index) noexcept {
+        detail::check_precondition(index < m_size);
+        return data(index);
+    }
     const_reference operator[](size_t index) const noexcept {
+        detail::check_precondition(index < m_size);
         return data(index);
     }
 
     // Get first element, equivalent to v[0]
     // Requires: size() > 0
-    reference front() noexcept { return data(0); }
-    const_reference front() const noexcept { return data(0); }
+    reference front() noexcept {
+        detail::check_precondition(m_size != 0);
+        return data(0);
+    }
+    const_reference front() const noexcept {
+        detail::check_precondition(m_size != 0);
+        return data(0);
+    }
 
     // Get last element, equivalent to v[v.size() - 1]
     // Requires: size() > 0
-    reference back() noexcept { return data(m_size - 1); }
-    const_reference back() const noexcept { return data(m_size - 1); }
+    reference back() noexcept {
+        detail::check_precondition(m_size != 0);
+        return data(m_size - 1);
+    }
+    const_reference back() const noexcept {
+        detail::check_precondition(m_size != 0);
+        return data(m_size - 1);
+    }
 
     // Get underlying data as a raw pointer
     // Equivalent to &v[0]
-    pointer data() noexcept { return reinterpret_cast<pointer>(&m_data[0]); }
+    // The elements are at a constant offset from the start of the object
+    pointer data() noexcept {
+        return reinterpret_cast<pointer>(
+            reinterpret_cast<char*>(this) + layout::offset());
+    }
     const_pointer data() const noexcept {
-        return reinterpret_cast<const_pointer>(&m_data[0]);
+        return reinterpret_cast<const_pointer>(
+            reinterpret_cast<const char*>(this) + layout::offset());
     }
 
     // ITERATORS
@@ -227,13 +830,21 @@ struct static_vector {
     // `rbegin()` refers to the last element (`end() - 1`) and `rend()` refers
     // to one past `begin()`
     // Returns: iterator to the first element in reverse order
-    reverse_iterator rbegin() noexcept { return data() + m_size; }
-    const_reverse_iterator rbegin() const noexcept { return data() + m_size; }
-    const_reverse_iterator crbegin() const noexcept { return data() + m_size; }
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
+    const_reverse_iterator crbegin() const noexcept {
+        return const_reverse_iterator(end());
+    }
     // Returns: iterator to one past the last element in reverse order
-    reverse_iterator rend() noexcept { return data(); }
-    const_reverse_iterator rend() const noexcept { return data(); }
-    const_reverse_iterator crend() const noexcept { return data(); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
+    const_reverse_iterator crend() const noexcept {
+        return const_reverse_iterator(begin());
+    }
 
     // CAPACITY
 
@@ -247,80 +858,78 @@ struct static_vector {
     bool empty() const noexcept { return m_size == 0; }
 
     // Is it full? Note: added in addition to std::vector interface
-    bool full() const noexcept { return m_size == static_capacity; }
+    bool full() const noexcept { return m_size == m_capacity; }
 
     // Max possible size
-    size_type capacity() const noexcept { return static_capacity; }
+    size_type capacity() const noexcept { return m_capacity; }
 
     // Max possible size
-    size_type max_size() const noexcept { return static_capacity; }
+    size_type max_size() const noexcept { return m_capacity; }
 
     // reserve intentionally not defined, but it could be a no-op.
     // shrink_to_fit intentionally not defined, but it could be a no-op.
 
+    // LOOKUP
+
+    // Note: added in addition to std::vector interface
+
+    // Find the first element equal to `value`
+    // Returns: iterator to the element, or `end()` if there is none
+    // Complexity: O(size())
+    iterator find(const value_type& value) {
+        return std::find(begin(), end(), value);
+    }
+    const_iterator find(const value_type& value) const {
+        return std::find(begin(), end(), value);
+    }
+
+    // Is there an element equal to `value`?
+    bool contains(const value_type& value) const {
+        return find(value) != end();
+    }
+
     // MODIFIERS
 
     // Clear the vector
     // Ensures: size() = 0, all objects destructed
     // Complexity: O(size()) for non-trivially destructible value_type,
     // otherwise constant.
-    void clear() {
-        if (!std::is_trivially_destructible<value_type>::value)
-            std::for_each(begin(), end(), [](reference r) { r.~value_type(); });
+    // Exceptions: noexcept iff the destructor of value_type is
+    void clear() noexcept(std::is_nothrow_destructible<value_type>::value) {
+        destroy(begin(), end());
         m_size = 0;
+        size_changed();
     }
 
     // Insert element at specific position
     // Requires: valid `pos` iterator, including begin() and end() inclusive.
     // Ensures: new `value_type` copy_constructed at `pos`
-    // Complexity: exactly `end()` - `pos` moves and one copy
+    // Complexity: exactly `end()` - `pos` moves (or one memmove for trivially
+    // relocatable value_type) and one copy
     iterator insert(const_iterator pos, const value_type& value) {
-        if (full())
-            throw std::out_of_range("size()");
-        // Need mutable iterator to change items. Cast is legal in non-const
-        // methos.
-        iterator mut_pos = const_cast<iterator>(pos);
-        // move_backward is recommended when the end of the target range is
-        // outside the input range, last element is moved first
-        std::move_backward(mut_pos, end(), end() + 1);
-        // Construct value, do not assign nonexistent
-        new (mut_pos) value_type(value);
-        m_size++;
-        return mut_pos;
+        return emplace(pos, value);
     }
     iterator insert(const_iterator pos, value_type&& value) {
-        if (full())
-            throw std::out_of_range("size()");
-        // Need mutable iterator to change items. Cast is legal in non-const
-        // methos.
-        iterator mut_pos = const_cast<iterator>(pos);
-        // move_backward is recommended when the end of the target range is
-        // outside the input range, last element is moved first
-        std::move_backward(mut_pos, end(), end() + 1);
-        // Construct value, do not assign nonexistent
-        new (mut_pos) value_type(std::move(value));
-        m_size++;
-        return mut_pos;
+        return emplace(pos, std::move(value));
     }
 
     // Insert `count` copies of `value` at `pos`
     iterator
     insert(const_iterator pos, size_type count, const value_type& value) {
-        if (m_size + count < m_size /*ovf*/ || static_capacity < m_size + count)
-            throw std::out_of_range("count");
+        if (m_size + count < m_size /*ovf*/ || m_capacity < m_size + count)
+            throw_out_of_range(detail::out_of_range_error::count);
+        check_position(pos);
         // Need mutable iterator to change items. Cast is legal in non-const
         // methos.
         iterator mut_pos = const_cast<iterator>(pos);
-        // move_backward is recommended when the end of the target range is
-        // outside the input range, last element is moved first
-        std::move_backward(mut_pos, end(), end() + count);
+        if (count == 0)
+            return mut_pos;
+        // Copy first, `value` may refer to an element that is shifted
+        value_type copy(value);
         // Construct value, do not assign nonexistent
-        std::for_each(
-            storage_begin() + (mut_pos - begin()),
-            storage_begin() + (mut_pos - begin()) + count,
-            [&](storage_type& store) { new (&store) value_type(value); });
-        m_size += count;
-        return mut_pos;
+        return insert_with(mut_pos, count, [&](iterator first) {
+            std::uninitialized_fill_n(first, count, copy);
+        });
     }
     template <typename InputIter>
     auto
@@ -330,108 +939,1443 @@ struct static_vector {
                 typename std::iterator_traits<InputIter>::reference,
                 decltype(*insert_begin)>::value,
             iterator> {
-        auto count = std::distance(insert_begin, insert_end);
-        if (count < 0 ||
-            m_size + static_cast<size_type>(count) < m_size /*ovf*/ ||
-            static_capacity < m_size + static_cast<size_type>(count)) {
-            throw std::out_of_range("std::distance(begin, end)");
-        }
-        // Need mutable iterator to change items. Cast is legal in non-const
-        // methos.
-        iterator mut_pos = const_cast<iterator>(pos);
-        // move_backward is recommended when the end of the target range is
-        // outside the input range, last element is moved first
-        std::move_backward(mut_pos, end(), end() + count);
-        std::for_each(
-            storage_begin() + (mut_pos - begin()),
-            storage_begin() + (mut_pos - begin()) + count,
-            [&](storage_type& store) {
-                new (&store) value_type(*insert_begin++);
-            });
-        m_size += count;
-        return mut_pos;
+        return insert_elements(
+            pos, insert_begin, insert_end,
+            detail::iterator_category_t<InputIter>{});
     }
-    // TODO insert(const_iterator pos, InputIter begin, InputIter end)
-    // TODO insert(init_list)
 
-    // Inserts new object at `pos` using `args...` as constructor arguments
-    // TODO documentation
+    // Construct a new element at `pos` from `args...`, which may refer to
+    // elements of the vector
+    // Requires: valid `pos` iterator, including begin() and end() inclusive.
+    // Returns: iterator to the new element
+    // Complexity: `end()` - `pos` moves (or one memmove for trivially
+    // relocatable value_type), plus one move unless `pos` is end()
+    // Exceptions: std::out_of_range if full(), and the exceptions of the
+    // constructor of value_type. Both leave the vector unchanged.
     template <typename... CtorArgs>
     iterator emplace(const_iterator pos, CtorArgs&&... args) {
         if (full())
-            throw std::out_of_range("size()");
+            throw_out_of_range(detail::out_of_range_error::size);
+        check_position(pos);
         // Need mutable iterator to change items. Cast is legal in non-const
         // methos.
         iterator mut_pos = const_cast<iterator>(pos);
-        // move_backward is recommended when the end of the target range is
-        // outside the input range, last element is moved first
-        std::move_backward(mut_pos, end(), end() + 1);
-        // Construct value, do not assign nonexistent
-        new (mut_pos) value_type(std::forward<CtorArgs>(args)...);
+        if (mut_pos == end()) {
+            annotate_size(m_size + 1);
+            annotation_guard guard{this};
+            new (mut_pos) value_type(std::forward<CtorArgs>(args)...);
+            guard.vector = nullptr;
+        } else {
+            // Construct before shifting, `args` may refer to an element that
+            // is shifted
+            value_type value(std::forward<CtorArgs>(args)...);
+            return insert_with(mut_pos, 1, [&](iterator first) {
+                new (first) value_type(std::move(value));
+            });
+        }
         m_size++;
+        size_changed();
         return mut_pos;
     }
 
     // Erase element at `pos`
-    // TODO docs
-    iterator erase(const_iterator pos) {
+    // Requires: valid dereferenceable `pos` iterator
+    // Returns: iterator to the element after the erased one
+    // Complexity: `end()` - `pos` - 1 moves (or one memmove for trivially
+    // relocatable value_type) and one destruction
+    iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+    // Erase the elements in [first, last)
+    // Requires: valid range of iterators into this static_vector
+    // Returns: iterator to the element after the erased ones
+    // Complexity: `end()` - `last` moves (or one memmove for trivially
+    // relocatable value_type) and `last` - `first` destructions
+    iterator erase(const_iterator first, const_iterator last) {
+        detail::check_precondition(
+            begin() <= first && first <= last && last <= end());
+        iterator mut_first = const_cast<iterator>(first);
+        iterator mut_last = const_cast<iterator>(last);
+        if (is_trivially_relocatable<value_type>::value) {
+            destroy(mut_first, mut_last);
+            std::memmove(
+                static_cast<void*>(mut_first),
+                static_cast<const void*>(mut_last),
+                (end() - mut_last) * sizeof(value_type));
+        } else {
+            // move forward, starting from mut_first and going towards end()
+            destroy(std::move(mut_last, end(), mut_first), end());
+        }
+        observe_shift(end() - mut_last);
+        m_size -= mut_last - mut_first;
+        size_changed();
+        return mut_first;
+    }
+
+    // Erase element at `pos` by moving the last element in its place. Note:
+    // added in addition to std::vector interface
+    // Requires: valid dereferenceable `pos` iterator
+    // Ensures: the order of the remaining elements is not preserved
+    // Returns: iterator to the element that took the place of the erased one
+    // Complexity: constant
+    iterator unordered_erase(const_iterator pos) {
+        detail::check_precondition(begin() <= pos && pos < end());
         iterator mut_pos = const_cast<iterator>(pos);
-        mut_pos->~value_type();
-        // move forward, starting from mut_pos and going towards end()
-        std::move(mut_pos + 1, end(), mut_pos);
+        iterator last = end() - 1;
+        if (mut_pos != last) {
+            if (is_trivially_relocatable<value_type>::value) {
+                destroy(mut_pos, mut_pos + 1);
+                std::memcpy(
+                    static_cast<void*>(mut_pos),
+                    static_cast<const void*>(last), sizeof(value_type));
+                m_size--;
+                size_changed();
+                return mut_pos;
+            }
+            *mut_pos = std::move(*last);
+        }
+        destroy(last, last + 1);
         m_size--;
+        size_changed();
         return mut_pos;
     }
 
-    // TODO erase(const_iterator begin, const_iterator end)
-
     // Add `value` at the end of the list
     void push_back(const value_type& value) {
         if (full())
-            throw std::out_of_range("size()");
+            throw_out_of_range(detail::out_of_range_error::size);
+        annotate_size(m_size + 1);
+        annotation_guard guard{this};
         new (storage_end()) value_type(value);
+        guard.vector = nullptr;
         m_size++;
+        size_changed();
     }
     void push_back(value_type&& value) {
         if (full())
-            throw std::out_of_range("size()");
+            throw_out_of_range(detail::out_of_range_error::size);
+        annotate_size(m_size + 1);
+        annotation_guard guard{this};
         new (storage_end()) value_type(std::move(value));
+        guard.vector = nullptr;
         m_size++;
+        size_changed();
     }
 
-    // TODO emplace_back
-    // TODO pop_back
-    // TODO resize
-    // TODO swap
+    // Add `value` at the end of the list without checking the capacity. Note:
+    // added in addition to std::vector interface for hot loops where the size
+    // is already known to fit.
+    // Requires: !full()
+    // Complexity: constant
+    // Exceptions: noexcept iff the copy/move constructor of value_type is
+    void unchecked_push_back(const value_type& value) noexcept(
+        std::is_nothrow_copy_constructible<value_type>::value) {
+        detail::check_precondition(!full());
+        annotate_size(m_size + 1);
+        annotation_guard guard{this};
+        new (storage_end()) value_type(value);
+        guard.vector = nullptr;
+        m_size++;
+        size_changed();
+    }
+    void unchecked_push_back(value_type&& value) noexcept(
+        std::is_nothrow_move_constructible<value_type>::value) {
+        detail::check_precondition(!full());
+        annotate_size(m_size + 1);
+        annotation_guard guard{this};
+        new (storage_end()) value_type(std::move(value));
+        guard.vector = nullptr;
+        m_size++;
+        size_changed();
+    }
 
-private:
+    // Add the elements of [first, last) at the end without checking the
+    // capacity. Note: added in addition to std::vector interface.
+    // Requires: the range fits, `std::distance(first, last) <= capacity() -
+    // size()`, and does not refer to elements of the static_vector
+    // Complexity: O(std::distance(first, last))
+    // Exceptions: the exceptions of the constructor of value_type, which
+    // leave the size unchanged
+    template <typename Iter> void unchecked_append(Iter first, Iter last) {
+        const auto count = std::distance(first, last);
+        detail::check_precondition(
+            0 <= count &&
+            static_cast<size_type>(count) <= m_capacity - m_size);
+        annotate_size(m_size + static_cast<size_type>(count));
+        annotation_guard guard{this};
+        std::uninitialized_copy(first, last, end());
+        guard.vector = nullptr;
+        m_size += static_cast<size_type>(count);
+        size_changed();
+    }
+
+    // Construct a new element at the end from `args...`
+    // Returns: reference to the new element
+    // Complexity: constant
+    // Exceptions: std::out_of_range if full(), and the exceptions of the
+    // constructor of value_type
+    template <typename... CtorArgs> reference emplace_back(CtorArgs&&... args) {
+        if (full())
+            throw_out_of_range(detail::out_of_range_error::size);
+        annotate_size(m_size + 1);
+        annotation_guard guard{this};
+        pointer p =
+            new (storage_end()) value_type(std::forward<CtorArgs>(args)...);
+        guard.vector = nullptr;
+        m_size++;
+        size_changed();
+        return *p;
+    }
+
+    // Remove the last element
+    // Requires: !empty()
+    // Complexity: constant
+    // Exceptions: noexcept iff the destructor of value_type is
+    void pop_back() noexcept(std::is_nothrow_destructible<value_type>::value) {
+        detail::check_precondition(m_size != 0);
+        m_size--;
+        destroy(end(), end() + 1);
+        size_changed();
+    }
+
+    // Change the size to `count`, destroying the elements past `count` or
+    // appending new ones that are value-initialized (`resize(count)`), copies
+    // of `value` (`resize(count, value)`) or default-initialized
+    // (`resize(count, default_init)`, which leaves e.g. ints uninitialized).
+    // Note: the default_init overload is added in addition to std::vector
+    // interface.
+    // Complexity: O(|size() - count|)
+    // Exceptions: std::out_of_range if `count` is greater than `capacity()`,
+    // and the exceptions of the constructor of value_type
+    void resize(size_type count) {
+        resize_with(count, [](storage_type& store) {
+            new (static_cast<void*>(&store)) value_type();
+        });
+    }
+    void resize(size_type count, const value_type& value) {
+        resize_with(count, [&value](storage_type& store) {
+            new (static_cast<void*>(&store)) value_type(value);
+        });
+    }
+    void resize(size_type count, default_init_t) {
+        resize_with(count, [](storage_type& store) {
+            new (static_cast<void*>(&store)) value_type;
+        });
+    }
+
+    // Let `op(data(), count)` write up to `count` elements in place and set
+    // the size to the count it returns, like C++23
+    // std::basic_string::resize_and_overwrite, e.g. for reading bytes with
+    // read(2) straight into the unused slots. Note: added in addition to
+    // std::vector interface, for trivial value_types only.
+    // Requires: `op` returns at most `count`; the elements in [size(), count)
+    // are indeterminate when it is called, and it writes those below the
+    // size it returns
+    // Complexity: constant, plus `op`
+    // Exceptions: std::out_of_range if `count` is greater than `capacity()`,
+    // and the exceptions of `op`, which leave the size unchanged
+    template <typename Operation>
+    void resize_and_overwrite(size_type count, Operation op) {
+        static_assert(std::is_trivially_default_constructible<T>::value &&
+                          std::is_trivially_destructible<T>::value,
+                      "resize_and_overwrite requires a trivial value_type");
+        if (m_capacity < count)
+            throw_out_of_range(detail::out_of_range_error::count);
+        annotate_size(std::max(count, m_size));
+        annotation_guard guard{this};
+        const size_type size = static_cast<size_type>(op(data(), count));
+        guard.vector = nullptr;
+        detail::check_precondition(size <= count);
+        m_size = size;
+        size_changed();
+    }
+
+    // CHECKPOINTS
+
+    // Note: added in addition to std::vector interface, for appending
+    // elements speculatively, e.g. the tokens of a backtracking parser, and
+    // removing them again on failure without erasing them one by one or
+    // copying the whole vector beforehand.
+
+    // Mark the current size to roll back to
+    // Complexity: constant
+    checkpoint_type checkpoint() const noexcept {
+        return checkpoint_type{m_size};
+    }
+
+    // Destroy the elements appended since `mark` was taken
+    // Requires: `mark` was taken from this vector and the elements before it
+    // were not removed since, i.e. `mark.size <= size()`
+    // Ensures: size() = mark.size
+    // Complexity: O(size() - mark.size) for non-trivially destructible
+    // value_type, otherwise constant.
+    // Exceptions: noexcept iff the destructor of value_type is
+    void rollback(checkpoint_type mark) noexcept(
+        std::is_nothrow_destructible<value_type>::value) {
+        detail::check_precondition(mark.size <= m_size);
+        destroy(begin() + mark.size, end());
+        m_size = mark.size;
+        size_changed();
+    }
+
+    // Take a checkpoint that is rolled back when the returned guard goes out
+    // of scope, unless it is committed first
+    checkpoint_guard scoped_checkpoint() noexcept {
+        return checkpoint_guard(*this);
+    }
+
+#ifdef PALOTASB_STATIC_VECTOR_RANGES
+    // RANGES
+
+    // Note: the C++23 std::vector interface, in C++20 builds. The elements
+    // are constructed straight from the range, e.g. a view pipeline, without
+    // a temporary container. A sized_range is checked against the capacity
+    // once up front; other ranges are read once and checked per element.
+    // Requires: the range does not refer to elements of the static_vector
+
+    // Add the elements of `range` at the end
+    // Complexity: O(size of `range`)
+    // Exceptions: std::out_of_range if they do not fit, and the exceptions of
+    // the constructor of value_type. Both leave the size unchanged.
+    template <detail::compatible_range<value_type> R>
+    void append_range(R&& range) {
+        if constexpr (std::ranges::sized_range<R>) {
+            const auto count = static_cast<size_type>(std::ranges::size(range));
+            if (m_capacity - m_size < count)
+                throw_out_of_range(detail::out_of_range_error::distance);
+            annotate_size(m_size + count);
+            annotation_guard guard{this};
+            construct_range(range, end());
+            guard.vector = nullptr;
+            m_size += count;
+            size_changed();
+        } else {
+            checkpoint_guard guard = scoped_checkpoint();
+            for (auto&& element : range)
+                emplace_back(std::forward<decltype(element)>(element));
+            guard.commit();
+        }
+    }
+
+    // Insert the elements of `range` at `pos`. Ranges that are not sized are
+    // appended and rotated into place.
+    // Returns: iterator to the first inserted element
+    // Complexity: O(size of `range` + `end()` - `pos`)
+    // Exceptions: std::out_of_range if they do not fit, which leaves the
+    // static_vector unchanged, and the exceptions of the constructor and
+    // move of value_type
+    template <detail::compatible_range<value_type> R>
+    iterator insert_range(const_iterator pos, R&& range) {
+        check_position(pos);
+        const size_type index = static_cast<size_type>(pos - begin());
+        if constexpr (std::ranges::sized_range<R>) {
+            const auto count = static_cast<size_type>(std::ranges::size(range));
+            if (m_capacity - m_size < count)
+                throw_out_of_range(detail::out_of_range_error::distance);
+            insert_with(begin() + index, count, [&](iterator first) {
+                construct_range(range, first);
+            });
+        } else {
+            const size_type old_size = m_size;
+            append_range(std::forward<R>(range));
+            rotate_appended(index, old_size);
+        }
+        return begin() + index;
+    }
+
+    // Replace the contents with the elements of `range`, assigning over the
+    // existing elements like assign()
+    // Complexity: O(max(size(), size of `range`))
+    // Exceptions: std::out_of_range if they do not fit, before any change
+    // for a sized_range, and the exceptions of the constructor and
+    // assignment of value_type
+    template <detail::compatible_range<value_type> R>
+    void assign_range(R&& range) {
+        if constexpr (std::ranges::sized_range<R>) {
+            if (m_capacity < static_cast<size_type>(std::ranges::size(range)))
+                throw_out_of_range(detail::out_of_range_error::distance);
+        }
+        auto first = std::ranges::begin(range);
+        const auto last = std::ranges::end(range);
+        iterator out = begin();
+        for (; out != end() && first != last; ++out, ++first)
+            *out = *first;
+        if (out != end()) {
+            destroy(out, end());
+            m_size = static_cast<size_type>(out - begin());
+            size_changed();
+            return;
+        }
+        append_range(std::ranges::subrange(std::move(first), last));
+    }
+#endif
+
+protected:
     // Use a specific storage type to satisfy alignment requirements
-    using storage_type =
-        std::aligned_storage_t<sizeof(value_type), alignof(value_type)>;
-    // The array providing the inline storage for the elements.
-    std::array<storage_type, static_capacity> m_data = {};
+    using storage_type = detail::storage_type<value_type>;
+    using layout = detail::static_vector_layout<value_type>;
+
+    // Only static_vector constructs and destroys a static_vector_ref
+    static_vector_ref(
+        size_type capacity, detail::profile_stats* stats,
+        const detail::observer_hooks* observer) noexcept
+        : m_capacity(capacity) {
+        profile_init(stats);
+        observe_init(observer);
+    }
+    static_vector_ref(const static_vector_ref&) = delete;
+    ~static_vector_ref() = default;
+
     // The current occupied size of the static_vector
     size_type m_size = 0;
+    // The capacity of the static_vector
+    size_type m_capacity;
 
     // Get data by index, used for convenience instead of (*this)[index]
     // Note that as opposed to data(), these return a `reference`, not `pointer`
-    reference data(size_t index) noexcept {
-        return *reinterpret_cast<pointer>(&m_data[index]);
+    reference data(size_t index) noexcept { return data()[index]; }
+    const_reference data(size_t index) const noexcept { return data()[index]; }
+
+    // Get iterators for storage
+    storage_type* storage_begin() noexcept {
+        return reinterpret_cast<storage_type*>(data());
     }
-    const_reference data(size_t index) const noexcept {
-        return *reinterpret_cast<const_pointer>(&m_data[index]);
+    storage_type* storage_end() noexcept { return storage_begin() + m_size; }
+
+    // Destroy the elements in [first, last) without changing the size
+    static void destroy(iterator first, iterator last) noexcept(
+        std::is_nothrow_destructible<value_type>::value) {
+        if (!std::is_trivially_destructible<value_type>::value)
+            std::for_each(first, last, [](reference r) { r.~value_type(); });
     }
 
-    // Get iterators for storage
-    storage_type* storage_begin() noexcept { return &m_data[0]; }
-    storage_type* storage_end() noexcept { return &m_data[m_size]; }
+    // Destroy the elements past `count` or construct new ones up to `count`
+    // with `construct(storage_type&)`. The size is updated after each
+    // construction so that a throwing constructor leaves a valid vector.
+    template <typename Construct>
+    void resize_with(size_type count, Construct construct) {
+        if (m_capacity < count)
+            throw_out_of_range(detail::out_of_range_error::count);
+        if (count <= m_size) {
+            destroy(begin() + count, end());
+            m_size = count;
+            size_changed();
+            return;
+        }
+        annotate_size(count);
+        annotation_guard guard{this};
+        for (; m_size < count; m_size++)
+            construct(*storage_end());
+        guard.vector = nullptr;
+        size_changed();
+    }
+
+    // Replace the contents with the `count` elements starting at `first`,
+    // assigning over the existing elements before constructing new ones.
+    // Requires: count <= capacity(), `first` does not refer to an element
+    template <typename Iter> void assign_n(Iter first, size_type count) {
+        size_type common = std::min(count, m_size);
+        Iter middle = std::next(first, common);
+        std::copy(first, middle, begin());
+        if (count <= m_size) {
+            destroy(begin() + count, end());
+        } else {
+            annotate_size(count);
+            annotation_guard guard{this};
+            std::uninitialized_copy(
+                middle, std::next(middle, count - common), end());
+            guard.vector = nullptr;
+        }
+        m_size = count;
+        size_changed();
+    }
+
+    // Construct the elements of [first, last) at the end. Forward iterators
+    // are counted first and checked against the capacity once, in constant
+    // time for random access iterators. Input iterators can only be read
+    // once, so each element is checked as it is read and the appended ones
+    // are rolled back if the capacity runs out.
+    // Exceptions: std::out_of_range if they do not fit, and the exceptions
+    // of the constructor of value_type. Both leave the size unchanged.
+    template <typename Iter>
+    void append_elements(Iter first, Iter last, std::forward_iterator_tag) {
+        const auto count = std::distance(first, last);
+        if (count < 0 || m_capacity - m_size < static_cast<size_type>(count))
+            throw_out_of_range(detail::out_of_range_error::distance);
+        annotate_size(m_size + static_cast<size_type>(count));
+        annotation_guard guard{this};
+        std::uninitialized_copy(first, last, end());
+        guard.vector = nullptr;
+        m_size += static_cast<size_type>(count);
+        size_changed();
+    }
+    template <typename Iter>
+    void append_elements(Iter first, Iter last, std::input_iterator_tag) {
+        checkpoint_guard guard = scoped_checkpoint();
+        for (; first != last; ++first)
+            emplace_back(*first);
+        guard.commit();
+    }
+
+    // Insert the elements of [first, last) at `pos`. Input iterators are
+    // appended as they are read and rotated into place.
+    template <typename Iter>
+    iterator insert_elements(
+        const_iterator pos, Iter first, Iter last, std::forward_iterator_tag) {
+        auto count = std::distance(first, last);
+        if (count < 0 ||
+            m_size + static_cast<size_type>(count) < m_size /*ovf*/ ||
+            m_capacity < m_size + static_cast<size_type>(count)) {
+            throw_out_of_range(detail::out_of_range_error::distance);
+        }
+        check_position(pos);
+        // Need mutable iterator to change items. Cast is legal in non-const
+        // methos.
+        iterator mut_pos = const_cast<iterator>(pos);
+        return insert_with(
+            mut_pos, static_cast<size_type>(count),
+            [&](iterator out) { std::uninitialized_copy(first, last, out); });
+    }
+    template <typename Iter>
+    iterator insert_elements(
+        const_iterator pos, Iter first, Iter last, std::input_iterator_tag) {
+        check_position(pos);
+        const size_type index = static_cast<size_type>(pos - begin());
+        const size_type old_size = m_size;
+        append_elements(first, last, std::input_iterator_tag{});
+        rotate_appended(index, old_size);
+        return begin() + index;
+    }
+
+    // Move the elements appended after the first `old_size` to `index`
+    void rotate_appended(size_type index, size_type old_size) {
+        observe_shift(old_size - index);
+        std::rotate(begin() + index, begin() + old_size, end());
+    }
+
+    // Replace the contents with the elements of [first, last). Input
+    // iterators are assigned over the existing elements as they are read.
+    template <typename Iter>
+    void assign_elements(Iter first, Iter last, std::forward_iterator_tag) {
+        auto count = std::distance(first, last);
+        if (count < 0 || m_capacity < static_cast<size_type>(count))
+            throw_out_of_range(detail::out_of_range_error::distance);
+        assign_n(first, static_cast<size_type>(count));
+    }
+    template <typename Iter>
+    void assign_elements(Iter first, Iter last, std::input_iterator_tag) {
+        iterator out = begin();
+        for (; out != end() && first != last; ++out, ++first)
+            *out = *first;
+        if (out == end()) {
+            append_elements(first, last, std::input_iterator_tag{});
+            return;
+        }
+        destroy(out, end());
+        m_size = static_cast<size_type>(out - begin());
+        size_changed();
+    }
+
+    // Exchange the elements with `other` by swapping the common prefix and
+    // moving the rest of the longer one to the shorter one
+    // Requires: both sizes fit in both capacities
+    void swap_elements(static_vector_ref& other) noexcept(
+        std::is_nothrow_move_constructible<value_type>::value &&
+            detail::is_nothrow_swappable<value_type>::value) {
+        static_vector_ref& longer = m_size < other.m_size ? other : *this;
+        static_vector_ref& shorter = m_size < other.m_size ? *this : other;
+        iterator middle = longer.begin() + shorter.m_size;
+        std::swap_ranges(shorter.begin(), shorter.end(), longer.begin());
+        shorter.annotate_size(longer.m_size);
+        std::uninitialized_copy(
+            std::make_move_iterator(middle),
+            std::make_move_iterator(longer.end()), shorter.end());
+        destroy(middle, longer.end());
+        std::swap(m_size, other.m_size);
+        size_changed();
+        other.size_changed();
+    }
+
+    // Insert `count` elements at `pos` with `construct(first)`, which
+    // constructs them in the uninitialized storage at `first` and destroys
+    // the ones it constructed if it throws, like std::uninitialized_copy.
+    // Elements that move without throwing are constructed in a gap made by
+    // make_gap, which is closed again if `construct` throws. Others are
+    // constructed at the end and rotated into place, so that a throwing move
+    // leaves every slot below the size constructed.
+    // Returns: iterator to the first inserted element
+    // Requires: size() + count <= capacity()
+    template <typename Construct>
+    iterator insert_with(iterator pos, size_type count, Construct construct) {
+        const size_type index = static_cast<size_type>(pos - begin());
+        if (is_trivially_relocatable<value_type>::value ||
+            (std::is_nothrow_move_constructible<value_type>::value &&
+             std::is_nothrow_move_assignable<value_type>::value)) {
+            make_gap(pos, count);
+            gap_guard guard{this, pos, count};
+            construct(pos);
+            guard.vector = nullptr;
+            m_size += count;
+            size_changed();
+        } else {
+            const size_type old_size = m_size;
+            annotate_size(m_size + count);
+            annotation_guard guard{this};
+            construct(end());
+            guard.vector = nullptr;
+            m_size += count;
+            size_changed();
+            rotate_appended(index, old_size);
+        }
+        return begin() + index;
+    }
+
+    // Annotates the size of the vector on destruction unless `vector` is
+    // reset, so that the slots annotated for elements that failed to
+    // construct are poisoned again
+    struct annotation_guard {
+        static_vector_ref* vector;
+        ~annotation_guard() {
+            if (vector)
+                vector->annotate_size(vector->m_size);
+        }
+    };
+
+    // Closes the gap at `pos` on destruction unless `vector` is reset
+    struct gap_guard {
+        static_vector_ref* vector;
+        iterator pos;
+        size_type count;
+        ~gap_guard() {
+            if (vector)
+                vector->close_gap(pos, count);
+        }
+    };
+
+    // Shift the elements in [pos, end()) up by `count` places, leaving
+    // [pos, pos + count) as uninitialized storage. Does not change the size.
+    // Requires: size() + count <= capacity()
+    void make_gap(iterator pos, size_type count) {
+        annotate_size(m_size + count);
+        iterator last = end();
+        observe_shift(static_cast<size_type>(last - pos));
+        if (is_trivially_relocatable<value_type>::value) {
+            std::memmove(
+                static_cast<void*>(pos + count), static_cast<const void*>(pos),
+                (last - pos) * sizeof(value_type));
+        } else if (count < static_cast<size_type>(last - pos)) {
+            // The last `count` elements move to uninitialized storage, the
+            // rest are move assigned to existing elements. Last element is
+            // moved first.
+            std::uninitialized_copy(
+                std::make_move_iterator(last - count),
+                std::make_move_iterator(last), last);
+            std::move_backward(pos, last - count, last);
+            destroy(pos, pos + count);
+        } else {
+            std::uninitialized_copy(
+                std::make_move_iterator(pos), std::make_move_iterator(last),
+                pos + count);
+            destroy(pos, last);
+        }
+    }
+
+    // Undo make_gap(pos, count): shift the elements after the gap back down
+    // to `pos`. Only called for value_types that move without throwing.
+    void close_gap(iterator pos, size_type count) noexcept {
+        iterator first = pos + count;
+        iterator last = end() + count;
+        if (is_trivially_relocatable<value_type>::value) {
+            std::memmove(
+                static_cast<void*>(pos), static_cast<const void*>(first),
+                (last - first) * sizeof(value_type));
+        } else if (count < static_cast<size_type>(last - first)) {
+            std::uninitialized_copy(
+                std::make_move_iterator(first),
+                std::make_move_iterator(first + count), pos);
+            std::move(first + count, last, first);
+            destroy(last - count, last);
+        } else {
+            std::uninitialized_copy(
+                std::make_move_iterator(first), std::make_move_iterator(last),
+                pos);
+            destroy(first, last);
+        }
+        annotate_size(m_size);
+    }
+
+#ifdef PALOTASB_STATIC_VECTOR_RANGES
+    // Construct the elements of a sized `range` in the uninitialized storage
+    // at `pos`, which has room for them. The constructed elements are
+    // destroyed if one of the constructors throws.
+    template <typename R> static void construct_range(R&& range, iterator pos) {
+        // No end for the output: libstdc++ 12 cannot compare its difference
+        // type to the integer-class one of e.g. views::iota of std::size_t
+        std::ranges::uninitialized_copy(
+            std::ranges::begin(range), std::ranges::end(range), pos,
+            std::unreachable_sentinel);
+    }
+#endif
+
+    // Throw because an operation would exceed the capacity
+    [[noreturn]] void throw_out_of_range(detail::out_of_range_error error) {
+        profile_overflow();
+        observe_overflow();
+        detail::throw_out_of_range(error);
+    }
+
+    // Stop the program in hardened builds unless `pos` is a valid position
+    // to insert at, in [begin(), end()]
+    void check_position(const_iterator pos) const noexcept {
+        detail::check_precondition(begin() <= pos && pos <= end());
+    }
+
+    // Called after every change of the size
+    void size_changed() noexcept {
+        profile_size();
+        observe_size();
+        annotate_size(m_size);
+    }
+
+    // Profiling hooks, see detail::profile_stats. They compile to nothing
+    // unless PALOTASB_STATIC_VECTOR_PROFILE is defined.
+#ifdef PALOTASB_STATIC_VECTOR_PROFILE
+    // Statistics of the static_vector<T, Capacity> type
+    detail::profile_stats* m_profile_stats;
+    // Largest size this object has had
+    size_type m_profile_peak = 0;
+
+    void profile_init(detail::profile_stats* stats) noexcept {
+        m_profile_stats = stats;
+    }
+    void profile_size() noexcept {
+        if (m_profile_peak < m_size)
+            m_profile_peak = m_size;
+    }
+    void profile_overflow() noexcept { m_profile_stats->record_overflow(); }
+    void profile_destroy() noexcept {
+        m_profile_stats->record_peak(m_profile_peak);
+    }
+#else
+    void profile_init(detail::profile_stats*) noexcept {}
+    void profile_size() noexcept {}
+    void profile_overflow() noexcept {}
+    void profile_destroy() noexcept {}
+#endif
+
+    // Observer hooks, see null_observer. They compile to nothing unless
+    // PALOTASB_STATIC_VECTOR_OBSERVE is defined.
+#ifdef PALOTASB_STATIC_VECTOR_OBSERVE
+    // The hooks of Policy::observer, null for null_observer
+    const detail::observer_hooks* m_observer;
+    // The size last reported to the observer
+    size_type m_observed_size = 0;
+
+    void observe_init(const detail::observer_hooks* observer) noexcept {
+        m_observer = observer;
+        if (m_observer)
+            m_observer->construct(m_capacity);
+    }
+    void observe_size() noexcept {
+        if (!m_observer || m_size == m_observed_size)
+            return;
+        (m_observed_size < m_size ? m_observer->grow : m_observer->shrink)(
+            m_size, m_capacity);
+        m_observed_size = m_size;
+    }
+    void observe_shift(size_type count) noexcept {
+        if (m_observer && count != 0)
+            m_observer->shift(count);
+    }
+    void observe_overflow() noexcept {
+        if (m_observer)
+            m_observer->overflow(m_capacity);
+    }
+#else
+    void observe_init(const detail::observer_hooks*) noexcept {}
+    void observe_size() noexcept {}
+    void observe_shift(size_type) noexcept {}
+    void observe_overflow() noexcept {}
+#endif
+
+    // AddressSanitizer annotations of the unused slots. They compile to
+    // nothing unless PALOTASB_STATIC_VECTOR_HARDENED is defined in a build
+    // with AddressSanitizer.
+#ifdef PALOTASB_STATIC_VECTOR_ANNOTATE
+    // The number of slots AddressSanitizer lets access, all of them until
+    // the static_vector constructor annotates them
+    size_type m_annotated_size = m_capacity;
+
+    // Make the slots below `size` accessible and poison the ones above it,
+    // so that AddressSanitizer reports accessing them as a
+    // container-overflow. Called before constructing elements past the size,
+    // after every change of the size, and with the capacity on destruction.
+    // The annotated range ends at the last 8 byte shadow granule boundary of
+    // the storage, so that no bytes of other objects sharing the last granule
+    // are poisoned.
+    void annotate_size(size_type size) noexcept {
+        const std::size_t granule = 8;
+        const char* first = reinterpret_cast<const char*>(data());
+        const char* last =
+            first + m_capacity * sizeof(value_type) / granule * granule;
+        __sanitizer_annotate_contiguous_container(
+            first, last,
+            std::min(first + m_annotated_size * sizeof(value_type), last),
+            std::min(first + size * sizeof(value_type), last));
+        m_annotated_size = size;
+    }
+#else
+    void annotate_size(size_type) noexcept {}
+#endif
+};
+
+// Checkpoint of a static_vector_ref that rolls back on destruction unless
+// commit() was called, see static_vector_ref::scoped_checkpoint()
+template <typename T> class static_vector_ref<T>::checkpoint_guard {
+public:
+    explicit checkpoint_guard(static_vector_ref& vector) noexcept
+        : m_vector(&vector), m_mark(vector.checkpoint()) {}
+    // The moved-from guard no longer rolls back
+    checkpoint_guard(checkpoint_guard&& other) noexcept
+        : m_vector(other.m_vector), m_mark(other.m_mark) {
+        other.m_vector = nullptr;
+    }
+    checkpoint_guard(const checkpoint_guard&) = delete;
+    checkpoint_guard& operator=(const checkpoint_guard&) = delete;
+    ~checkpoint_guard() { rollback(); }
+
+    // The checkpoint
+    checkpoint_type mark() const noexcept { return m_mark; }
+
+    // Keep the elements appended since the checkpoint
+    void commit() noexcept { m_vector = nullptr; }
+
+    // Roll back now instead of on destruction, unless already committed
+    void rollback() noexcept(std::is_nothrow_destructible<T>::value) {
+        if (m_vector)
+            m_vector->rollback(m_mark);
+        m_vector = nullptr;
+    }
+
+private:
+    static_vector_ref* m_vector;
+    checkpoint_type m_mark;
+};
+
+// "PalotasB" Static Vector.
+// This class template behaves exactly like std::vector except that it
+// implements a fixed-size inline storage with the capacity defined by the
+// Capacity template parameter.
+// Main differences between static_vector and std::vector
+//  - static_vector does not have an Allocater template parameter as all
+// allocations are inline. (Its behaviour could be mostly implemented with a
+// specialized allocater type that only returns inline references.)
+//  - static_vector never reallocates and therefore iterators never become
+// invalid when the corresponding std::vector method might invalidate because of
+// reallocation.
+//  - `reserve(size_type)` and `shrink_to_fit()` are intentionally not
+// implemented because their existence would be misleading to the user.
+//  - static_vector<T, Capacity> derives from static_vector_ref<T>, which
+// implements everything but construction, destruction and swap independently
+// of the capacity.
+// Layout: the size and the capacity (two std::size_t) are followed by the
+// elements, all inside the object. Without a policy alignment,
+//   sizeof(static_vector<T, N>) ==
+//       round_up(round_up(2 * sizeof(size_t), alignof(T)) + N * sizeof(T),
+//                max(alignof(size_t), alignof(T)))
+// e.g. 16 + 4 * N rounded up to a multiple of 8 for int on 64-bit platforms.
+// A Policy::alignment larger than that rounds the start and the size up to a
+// multiple of it instead, and a Policy::simd_width replaces N with
+// padded_capacity. Profiling builds add two more fields.
+template <
+    typename T, std::size_t Capacity,
+    typename Policy = static_vector_policy>
+struct alignas(detail::max_alignment(
+    Policy::alignment, alignof(static_vector_ref<T>),
+    alignof(detail::storage_type<T>))) static_vector : static_vector_ref<T> {
+private:
+    using base = static_vector_ref<T>;
+
+public:
+    // MEMBER TYPES
+
+    using typename base::value_type;
+    using typename base::size_type;
+    using typename base::difference_type;
+    using typename base::reference;
+    using typename base::const_reference;
+    using typename base::pointer;
+    using typename base::const_pointer;
+    using typename base::iterator;
+    using typename base::const_iterator;
+    using typename base::reverse_iterator;
+    using typename base::const_reverse_iterator;
+    using typename base::checkpoint_type;
+    using typename base::checkpoint_guard;
+    // The static capacity of the static_vector
+    static const size_type static_capacity = Capacity;
+    // The number of element slots in the storage: the capacity, rounded up
+    // to fill whole Policy::simd_width registers. Note: added in addition to
+    // std::vector interface.
+    static const size_type padded_capacity = detail::padded_capacity(
+        Capacity, sizeof(T), Policy::simd_width);
+    // The policy of the static_vector, see static_vector_policy
+    using policy_type = Policy;
+
+    // CONSTRUCTORS
+
+    // Default constructor
+    // Requires: nothing
+    // Ensures: The static_vector contains zero elements.
+    // Complexity: constant
+    // Exceptions: noexcept
+    static_vector() noexcept
+        : base(Capacity, profile_stats(), observer_hooks()) {
+        annotate_size(0);
+    }
+
+    // "N copies of one value" constructor
+    // Requires:
+    //  `count` is less than or equal to `capacity`
+    // Ensures:
+    //  The static_vector contains `count` elements copy-constructed from
+    //  `value`.
+    // Complexity: O(count)
+    // Exceptions: noexcept iff the copy constructor of value_type is noexcept
+    static_vector(size_type count, const_reference value) //
+        noexcept(std::is_nothrow_copy_constructible<value_type>::value)
+        : static_vector() {
+        detail::check_precondition(count <= Capacity);
+        m_size = count;
+        annotate_size(count);
+        std::uninitialized_fill(this->begin(), this->end(), value);
+        size_changed();
+    }
+
+    // "N default constructed items" constructor
+    // Exceptions: noexcept iff the default constructor of value_type is
+    static_vector(size_type count) noexcept(
+        std::is_nothrow_default_constructible<value_type>::value)
+        : static_vector() {
+        detail::check_precondition(count <= Capacity);
+        m_size = count;
+        annotate_size(count);
+        std::for_each( // C++17 would use std::uninitialized_default_construct
+            storage_begin(), storage_end(), [](storage_type& store) {
+                new (static_cast<void*>(&store)) value_type;
+            });
+        size_changed();
+    }
+
+    // Initializer list constructor
+    static_vector(std::initializer_list<value_type> init_list)
+        : static_vector() {
+        detail::check_precondition(init_list.size() <= Capacity);
+        m_size = init_list.size();
+        annotate_size(m_size);
+        std::uninitialized_copy(
+            init_list.begin(), init_list.end(), this->begin());
+        size_changed();
+    }
+
+    // TODO maybe implement trivial copy/move/destruct if `value_type` supports
+    // it
+
+    // The copy and move operations are noexcept exactly when the operations
+    // they use on value_type are. This matters beyond exception safety:
+    // std::vector<static_vector> only moves its elements when reallocating if
+    // the move constructor is noexcept, and copies them otherwise.
+
+    // Copy constructor
+    // Exceptions: noexcept iff the copy constructor of value_type is
+    static_vector(const static_vector& other) noexcept(
+        std::is_nothrow_copy_constructible<value_type>::value)
+        : static_vector() {
+        construct_from(other, other.begin(), unrolled{});
+    }
+
+    // Copy assignment
+    // Exceptions: noexcept iff the copy constructor and copy assignment of
+    // value_type are
+    static_vector& operator=(const static_vector& other) noexcept(
+        std::is_nothrow_copy_constructible<value_type>::value &&
+            std::is_nothrow_copy_assignable<value_type>::value) {
+        if (&other == this)
+            return *this;
+        assign_from(other, other.begin(), unrolled{});
+        return *this;
+    }
+
+    // Move constructor
+    // Exceptions: noexcept iff the move constructor of value_type is
+    static_vector(static_vector&& other) noexcept(
+        std::is_nothrow_move_constructible<value_type>::value)
+        : static_vector() {
+        construct_from(
+            other, std::make_move_iterator(other.begin()), unrolled{});
+    }
+
+    // Move assignment
+    // Exceptions: noexcept iff the move constructor and move assignment of
+    // value_type are
+    static_vector& operator=(static_vector&& other) noexcept(
+        std::is_nothrow_move_constructible<value_type>::value &&
+            std::is_nothrow_move_assignable<value_type>::value) {
+        if (&other == this)
+            return *this;
+        assign_from(
+            other, std::make_move_iterator(other.begin()), unrolled{});
+        return *this;
+    }
+
+    // Iterator constructor with basic SFINAE mechanism to cancel use with
+    // non-iterator types. Single-pass input iterators, e.g.
+    // std::istream_iterator, are read once and the capacity is checked per
+    // element.
+    // Exceptions: std::out_of_range if the range is longer than `capacity()`,
+    // and the exceptions of the constructor of value_type
+    template <
+        typename Iter, typename = decltype(*std::declval<Iter&>()),
+        typename = decltype(++std::declval<Iter&>())>
+    static_vector(Iter input_begin, Iter input_end) : static_vector() {
+        this->append_elements(
+            input_begin, input_end, detail::iterator_category_t<Iter>{});
+    }
+
+#ifdef PALOTASB_STATIC_VECTOR_RANGES
+    // Range constructor, see static_vector_ref::append_range. Note: the
+    // C++23 std::vector interface, in C++20 builds.
+    // Exceptions: std::out_of_range if the elements do not fit, and the
+    // exceptions of the constructor of value_type
+    template <detail::compatible_range<T> R>
+    static_vector(from_range_t, R&& range) : static_vector() {
+        this->append_range(std::forward<R>(range));
+    }
+#endif
+
+    // Destructor
+    // Ensures: all objects are destructed properly, but trivial destructors are
+    // not run.
+    // Complexity: O(size()) for non-trivially destructible value_type,
+    // otherwise constant.
+    // Exceptions: noexcept iff the destructor of value_type is
+    ~static_vector() noexcept(std::is_nothrow_destructible<value_type>::value) {
+        using mirror = detail::static_vector_mirror<
+            base, decltype(m_data), alignof(static_vector)>;
+        static_assert(
+            offsetof(mirror, elements) ==
+                    detail::static_vector_layout<T>::offset() &&
+                sizeof(mirror) == sizeof(static_vector),
+            "static_vector elements are not where static_vector_ref expects");
+        profile_destroy();
+        this->clear();
+        annotate_size(Capacity);
+    }
+
+    // The assignment operators and assign functions of static_vector_ref
+    using base::operator=;
+    using base::assign;
+
+    // The insert and erase functions of static_vector_ref. Inserting or
+    // erasing one element has straight-line versions for small capacities,
+    // see detail::is_unrolled.
+    using base::insert;
+    using base::erase;
+
+    iterator insert(const_iterator pos, const value_type& value) {
+        return insert_one(pos, value, unrolled{});
+    }
+    iterator insert(const_iterator pos, value_type&& value) {
+        return insert_one(pos, std::move(value), unrolled{});
+    }
+    iterator erase(const_iterator pos) { return erase_one(pos, unrolled{}); }
+
+    // static_vector_ref::find and contains, with straight-line versions
+    // for small capacities, see detail::is_unrolled_comparable
+    iterator find(const value_type& value) {
+        return const_cast<iterator>(
+            static_cast<const static_vector&>(*this).find(value));
+    }
+    const_iterator find(const value_type& value) const {
+        return find_one(value, detail::is_unrolled_comparable<T, Capacity>{});
+    }
+    bool contains(const value_type& value) const {
+        return find(value) != this->end();
+    }
+
+    // Exchange the contents with `other`
+    // Ensures: the elements of the common prefix are swapped, the remaining
+    // elements of the longer static_vector are moved to the shorter one. For
+    // trivially relocatable value_type the bytes of the common prefix are
+    // exchanged in chunks and the rest are copied with memcpy instead.
+    // Complexity: O(max(size(), other.size()))
+    // Exceptions: noexcept iff the move constructor and swap of value_type are
+    void swap(static_vector& other) noexcept(
+        std::is_nothrow_move_constructible<value_type>::value &&
+            detail::is_nothrow_swappable<value_type>::value) {
+        if (!is_trivially_relocatable<value_type>::value) {
+            base::swap_elements(other);
+            return;
+        }
+        // Swap the bytes of the common prefix, then relocate the surplus of
+        // the longer one behind them
+        static_vector& longer = m_size < other.m_size ? other : *this;
+        static_vector& shorter = m_size < other.m_size ? *this : other;
+        detail::swap_bytes(
+            static_cast<void*>(shorter.begin()),
+            static_cast<void*>(longer.begin()),
+            shorter.m_size * sizeof(value_type));
+        shorter.annotate_size(longer.m_size);
+        std::memcpy(
+            static_cast<void*>(shorter.end()),
+            static_cast<const void*>(longer.begin() + shorter.m_size),
+            (longer.m_size - shorter.m_size) * sizeof(value_type));
+        std::swap(m_size, other.m_size);
+        size_changed();
+        other.size_changed();
+    }
+
+private:
+    using typename base::storage_type;
+    using unrolled = detail::is_unrolled<T, Capacity>;
+    using base::m_size;
+    using base::destroy;
+    using base::storage_begin;
+    using base::storage_end;
+    using base::assign_n;
+    using base::throw_out_of_range;
+    using base::size_changed;
+    using base::profile_destroy;
+    using base::observe_shift;
+    using base::check_position;
+    using base::annotate_size;
+
+    // Copy or move construct the elements of `other`, the first of which is
+    // `first`. Small capacities copy the whole buffer without looking at the
+    // size.
+    template <typename Iter>
+    void construct_from(
+        const static_vector& other, Iter first, std::false_type) {
+        m_size = other.m_size;
+        annotate_size(m_size);
+        std::uninitialized_copy(
+            first, std::next(first, other.m_size), this->begin());
+        size_changed();
+    }
+    template <typename Iter>
+    void
+    construct_from(const static_vector& other, Iter, std::true_type) noexcept {
+        m_data = other.m_data;
+        m_size = other.m_size;
+        size_changed();
+    }
+
+    // Copy or move assign the elements of `other`, the first of which is
+    // `first`
+    template <typename Iter>
+    void assign_from(const static_vector& other, Iter first, std::false_type) {
+        assign_n(first, other.m_size);
+    }
+    template <typename Iter>
+    void assign_from(
+        const static_vector& other, Iter first, std::true_type) noexcept {
+        construct_from(other, first, std::true_type{});
+    }
+
+    template <typename U>
+    iterator insert_one(const_iterator pos, U&& value, std::false_type) {
+        return base::insert(pos, std::forward<U>(value));
+    }
+    template <typename U>
+    iterator insert_one(const_iterator pos, U&& value, std::true_type) {
+        if (this->full())
+            throw_out_of_range(detail::out_of_range_error::size);
+        check_position(pos);
+        const size_type index = pos - this->begin();
+        // Copy first, `value` may refer to an element that is shifted
+        const value_type copy(std::forward<U>(value));
+        // Every slot above `index` takes the one below it, last slot first
+        detail::unroll(
+            [&](size_type i) {
+                const size_type slot = Capacity - 1 - i;
+                m_data[slot] = m_data[slot - (index < slot)];
+            },
+            std::make_index_sequence<Capacity - 1>{});
+        new (static_cast<void*>(&m_data[index])) value_type(copy);
+        observe_shift(m_size - index);
+        m_size++;
+        size_changed();
+        return this->begin() + index;
+    }
+
+    iterator erase_one(const_iterator pos, std::false_type) {
+        return base::erase(pos);
+    }
+    iterator erase_one(const_iterator pos, std::true_type) noexcept {
+        detail::check_precondition(this->begin() <= pos && pos < this->end());
+        const size_type index = pos - this->begin();
+        // Every slot from `index` on takes the one above it
+        detail::unroll(
+            [&](size_type slot) {
+                m_data[slot] = m_data[slot + (index <= slot)];
+            },
+            std::make_index_sequence<Capacity - 1>{});
+        observe_shift(m_size - index - 1);
+        m_size--;
+        size_changed();
+        return this->begin() + index;
+    }
+
+    const_iterator find_one(const value_type& value, std::false_type) const {
+        return base::find(value);
+    }
+    // The bit of slot `size()` is set as a sentinel, so the lowest set bit is
+    // the first match or the size
+    const_iterator
+    find_one(const value_type& value, std::true_type) const noexcept {
+        unsigned matches = detail::slot_mask(
+            this->data(),
+            [&value](const value_type& x, size_type) { return x == value; },
+            std::make_index_sequence<Capacity>{});
+        return this->begin() +
+               detail::lowest_bit(
+                   (matches & detail::low_bits(m_size)) | (1u << m_size));
+    }
+
+    // The array providing the inline storage for the elements. It must be the
+    // first member, see detail::static_vector_layout.
+    std::array<storage_type, padded_capacity> m_data = {};
+
+#ifdef PALOTASB_STATIC_VECTOR_PROFILE
+    static detail::profile_stats* profile_stats() noexcept {
+        static detail::profile_stats stats(
+            typeid(static_vector), static_capacity);
+        return &stats;
+    }
+#else
+    static detail::profile_stats* profile_stats() noexcept { return nullptr; }
+#endif
+
+#ifdef PALOTASB_STATIC_VECTOR_OBSERVE
+    static const detail::observer_hooks* observer_hooks() noexcept {
+        return detail::observer_hooks_of<typename Policy::observer>();
+    }
+#else
+    static_assert(
+        std::is_same<typename Policy::observer, null_observer>::value,
+        "Policy::observer is only called if PALOTASB_STATIC_VECTOR_OBSERVE "
+        "is defined");
+    static const detail::observer_hooks* observer_hooks() noexcept {
+        return nullptr;
+    }
+#endif
 };
 
 // NON-MEMBER OPERATORS
 
-// TODO ==, !=
-// TODO < > <= >=
+// Exchange the contents of `a` and `b`, see static_vector::swap
+template <typename T, std::size_t Capacity, typename Policy>
+void swap(
+    static_vector<T, Capacity, Policy>& a,
+    static_vector<T, Capacity, Policy>& b) noexcept(noexcept(a.swap(b))) {
+    a.swap(b);
+}
+
+// Equality: same size and equal elements. Like the other comparisons it
+// accepts static_vectors of different capacities.
+// Complexity: O(size()), a single memcmp for element types whose equality is
+// that of their bytes
+template <typename T>
+bool operator==(const static_vector_ref<T>& a, const static_vector_ref<T>& b) {
+    return a.size() == b.size() &&
+           detail::equal_n(a.data(), b.data(), a.size());
+}
+template <typename T>
+bool operator!=(const static_vector_ref<T>& a, const static_vector_ref<T>& b) {
+    return !(a == b);
+}
+
+// Equality of static_vectors of the same type. Small capacities of bitwise
+// comparable elements compare all slots with straight-line code instead of
+// calling memcmp, see detail::is_unrolled_comparable.
+template <typename T, std::size_t Capacity, typename Policy>
+bool operator==(
+    const static_vector<T, Capacity, Policy>& a,
+    const static_vector<T, Capacity, Policy>& b) {
+    return detail::equal_slots<Capacity>(
+        a.data(), a.size(), b.data(), b.size(),
+        detail::is_unrolled_comparable<T, Capacity>{});
+}
+template <typename T, std::size_t Capacity, typename Policy>
+bool operator!=(
+    const static_vector<T, Capacity, Policy>& a,
+    const static_vector<T, Capacity, Policy>& b) {
+    return !(a == b);
+}
+
+// Lexicographical ordering
+// Complexity: O(min(a.size(), b.size())), a single memcmp for unsigned byte
+// element types
+template <typename T>
+bool operator<(const static_vector_ref<T>& a, const static_vector_ref<T>& b) {
+    if (detail::is_bytewise_ordered<T>::value) {
+        std::size_t common = std::min(a.size(), b.size());
+        int order = common == 0 ? 0
+                                : std::memcmp(
+                                      static_cast<const void*>(a.data()),
+                                      static_cast<const void*>(b.data()),
+                                      common);
+        return order < 0 || (order == 0 && a.size() < b.size());
+    }
+    return std::lexicographical_compare(a.begin(), a.end(), b.begin(), b.end());
+}
+template <typename T>
+bool operator>(const static_vector_ref<T>& a, const static_vector_ref<T>& b) {
+    return b < a;
+}
+template <typename T>
+bool operator<=(const static_vector_ref<T>& a, const static_vector_ref<T>& b) {
+    return !(b < a);
+}
+template <typename T>
+bool operator>=(const static_vector_ref<T>& a, const static_vector_ref<T>& b) {
+    return !(a < b);
+}
+
+// CAPACITY ALGEBRA
+
+// Functions whose results have capacities computed from those of their
+// arguments at compile time, so they never overflow and check no sizes at
+// run time. Lvalue arguments are copied, rvalues are moved from. Note: added
+// in addition to std::vector interface.
+
+namespace detail {
+
+// A `Result` static_vector of the elements [first + from, first + to)
+template <typename Result, typename Iter>
+Result slice(Iter first, std::size_t from, std::size_t to) {
+    Result result;
+    result.unchecked_append(std::next(first, from), std::next(first, to));
+    return result;
+}
+
+} // namespace detail
+
+// The elements of `a` followed by those of `b`
+// Complexity: O(a.size() + b.size())
+// Exceptions: the exceptions of the copy or move constructor of value_type
+template <typename T, std::size_t N, std::size_t M, typename Policy>
+static_vector<T, N + M, Policy> concat(
+    const static_vector<T, N, Policy>& a,
+    const static_vector<T, M, Policy>& b) {
+    static_vector<T, N + M, Policy> result;
+    result.unchecked_append(a.begin(), a.end());
+    result.unchecked_append(b.begin(), b.end());
+    return result;
+}
+template <typename T, std::size_t N, std::size_t M, typename Policy>
+static_vector<T, N + M, Policy>
+concat(static_vector<T, N, Policy>&& a, static_vector<T, M, Policy>&& b) {
+    static_vector<T, N + M, Policy> result;
+    result.unchecked_append(
+        std::make_move_iterator(a.begin()), std::make_move_iterator(a.end()));
+    result.unchecked_append(
+        std::make_move_iterator(b.begin()), std::make_move_iterator(b.end()));
+    return result;
+}
+
+// The first min(K, v.size()) elements
+// Complexity: O(min(K, v.size()))
+// Exceptions: the exceptions of the copy or move constructor of value_type
+template <std::size_t K, typename T, std::size_t N, typename Policy>
+static_vector<T, K, Policy> take(const static_vector<T, N, Policy>& v) {
+    static_assert(K <= N, "take<K> of static_vector<T, N> requires K <= N");
+    return detail::slice<static_vector<T, K, Policy>>(
+        v.begin(), 0, std::min(K, v.size()));
+}
+template <std::size_t K, typename T, std::size_t N, typename Policy>
+static_vector<T, K, Policy> take(static_vector<T, N, Policy>&& v) {
+    static_assert(K <= N, "take<K> of static_vector<T, N> requires K <= N");
+    return detail::slice<static_vector<T, K, Policy>>(
+        std::make_move_iterator(v.begin()), 0, std::min(K, v.size()));
+}
+
+// The elements after the first K, none if `v.size() <= K`
+// Complexity: O(v.size() - K)
+// Exceptions: the exceptions of the copy or move constructor of value_type
+template <std::size_t K, typename T, std::size_t N, typename Policy>
+static_vector<T, N - K, Policy> drop(const static_vector<T, N, Policy>& v) {
+    static_assert(K <= N, "drop<K> of static_vector<T, N> requires K <= N");
+    return detail::slice<static_vector<T, N - K, Policy>>(
+        v.begin(), std::min(K, v.size()), v.size());
+}
+template <std::size_t K, typename T, std::size_t N, typename Policy>
+static_vector<T, N - K, Policy> drop(static_vector<T, N, Policy>&& v) {
+    static_assert(K <= N, "drop<K> of static_vector<T, N> requires K <= N");
+    return detail::slice<static_vector<T, N - K, Policy>>(
+        std::make_move_iterator(v.begin()), std::min(K, v.size()), v.size());
+}
+
+// The pair of take<K>(v) and drop<K>(v)
+template <std::size_t K, typename T, std::size_t N, typename Policy>
+std::pair<static_vector<T, K, Policy>, static_vector<T, N - K, Policy>>
+split_at(const static_vector<T, N, Policy>& v) {
+    return {take<K>(v), drop<K>(v)};
+}
+template <std::size_t K, typename T, std::size_t N, typename Policy>
+std::pair<static_vector<T, K, Policy>, static_vector<T, N - K, Policy>>
+split_at(static_vector<T, N, Policy>&& v) {
+    // The two halves move from disjoint elements
+    return {take<K>(std::move(v)), drop<K>(std::move(v))};
+}
+
+// The elements of `v` in a static_vector of the larger capacity M. Use
+// take<M>(v) to keep at most M elements of a larger static_vector.
+// Complexity: O(v.size())
+// Exceptions: the exceptions of the copy or move constructor of value_type
+template <std::size_t M, typename T, std::size_t N, typename Policy>
+static_vector<T, M, Policy>
+static_vector_cast(const static_vector<T, N, Policy>& v) {
+    static_assert(M >= N, "static_vector_cast<M> requires M >= N");
+    return detail::slice<static_vector<T, M, Policy>>(v.begin(), 0, v.size());
+}
+template <std::size_t M, typename T, std::size_t N, typename Policy>
+static_vector<T, M, Policy>
+static_vector_cast(static_vector<T, N, Policy>&& v) {
+    static_assert(M >= N, "static_vector_cast<M> requires M >= N");
+    return detail::slice<static_vector<T, M, Policy>>(
+        std::make_move_iterator(v.begin()), 0, v.size());
+}
 
 } // namespace stlpb
 
+namespace std {
+
+// Hash of the elements, consistent with operator==. Element types whose
+// equality is that of their bytes are hashed in bulk, others by combining
+// std::hash of each element. Note: added in addition to std::vector
+// interface, std::vector<T> has no std::hash specialization.
+template <typename T, std::size_t Capacity, typename Policy>
+struct hash<stlpb::static_vector<T, Capacity, Policy>> {
+    std::size_t
+    operator()(const stlpb::static_vector<T, Capacity, Policy>& v) const {
+        return hash_elements(v, stlpb::detail::is_bitwise_comparable<T>{});
+    }
+
+private:
+    static std::size_t hash_elements(
+        const stlpb::static_vector_ref<T>& v, std::true_type) noexcept {
+        return stlpb::detail::hash_bytes(
+            static_cast<const void*>(v.data()), v.size() * sizeof(T));
+    }
+    static std::size_t
+    hash_elements(const stlpb::static_vector_ref<T>& v, std::false_type) {
+        std::size_t seed = v.size();
+        for (const T& x : v)
+            seed ^= std::hash<T>{}(x) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+        return seed;
+    }
+};
+
+} // namespace std
+
 #endif // PALOTASB_STATIC_VECTOR_H
@@ -0,0 +1,272 @@
+#ifndef PALOTASB_STATIC_VECTOR_AGGREGATED_H
+#define PALOTASB_STATIC_VECTOR_AGGREGATED_H
+
+#pragma once
+
+/** Copyrighted according to the LICENSE file.
+ * SPDX-License-Identifier: MIT
+ * */
+
+#include <palotasb/static_vector.hpp>
+
+#include <algorithm>        // std::min
+#include <array>            // std::array
+#include <cstddef>          // std::size_t
+#include <initializer_list> // std::initializer_list
+#include <limits>           // std::numeric_limits
+#include <tuple>            // std::tuple
+#include <type_traits>      // std::is_nothrow_*
+#include <utility>          // std::move, std::forward, std::index_sequence
+
+/** A static_vector that keeps aggregates of its elements, such as their sum
+ * or maximum, up to date as elements are appended and removed at the end.
+ *
+ * The Aggregate policy defines the aggregate as a fold over the elements:
+ *
+ *   struct my_aggregate {
+ *       using value_type = ...;
+ *       // The aggregate of no elements
+ *       static value_type identity();
+ *       // The aggregate of `accumulator`'s elements and `element`
+ *       static value_type combine(const value_type& accumulator,
+ *                                 const T& element);
+ *   };
+ *
+ * sum_aggregate, min_aggregate and max_aggregate are provided, and
+ * aggregates<A...> keeps several at once in a tuple.
+ *
+ * The vector stores the aggregate of every prefix of its elements, so
+ * push_back combines one element with the previous prefix, and pop_back and
+ * clear only forget prefixes. Neither needs an inverse operation, which max
+ * and min do not have. insert and erase in the middle mark the prefixes from
+ * their position dirty; aggregate() recomputes them when it is next called.
+ *
+ * The elements can be read but not modified in place. aggregate() is const
+ * but may update the prefixes, so like other lazily computed caches it is
+ * not safe to call concurrently on one object.
+ * */
+
+namespace stlpb {
+
+// The sum of the elements, 0 if empty
+template <typename T> struct sum_aggregate {
+    using value_type = T;
+    static value_type identity() noexcept { return T(0); }
+    static value_type combine(const value_type& sum, const T& element) {
+        return sum + element;
+    }
+};
+
+// The smallest element, std::numeric_limits<T>::max() if empty
+template <typename T> struct min_aggregate {
+    using value_type = T;
+    static value_type identity() noexcept {
+        return std::numeric_limits<T>::max();
+    }
+    static value_type combine(const value_type& min, const T& element) {
+        return element < min ? element : min;
+    }
+};
+
+// The largest element, std::numeric_limits<T>::lowest() if empty
+template <typename T> struct max_aggregate {
+    using value_type = T;
+    static value_type identity() noexcept {
+        return std::numeric_limits<T>::lowest();
+    }
+    static value_type combine(const value_type& max, const T& element) {
+        return max < element ? element : max;
+    }
+};
+
+// Several aggregates at once, e.g.
+// aggregates<sum_aggregate<double>, max_aggregate<double>>, whose value is
+// the tuple of theirs
+template <typename... Aggregates> struct aggregates {
+    using value_type = std::tuple<typename Aggregates::value_type...>;
+
+    static value_type identity() {
+        return value_type(Aggregates::identity()...);
+    }
+    template <typename T>
+    static value_type combine(const value_type& accumulator, const T& element) {
+        return combine(
+            accumulator, element, std::index_sequence_for<Aggregates...>{});
+    }
+
+private:
+    template <typename T, std::size_t... I>
+    static value_type combine(
+        const value_type& accumulator, const T& element,
+        std::index_sequence<I...>) {
+        return value_type(
+            Aggregates::combine(std::get<I>(accumulator), element)...);
+    }
+};
+
+template <
+    typename T, std::size_t Capacity, typename Aggregate,
+    typename Policy = static_vector_policy>
+class aggregated_static_vector {
+public:
+    // MEMBER TYPES
+
+    using vector_type = static_vector<T, Capacity, Policy>;
+    using aggregate_type = typename Aggregate::value_type;
+    using value_type = typename vector_type::value_type;
+    using size_type = typename vector_type::size_type;
+    using difference_type = typename vector_type::difference_type;
+    using const_reference = typename vector_type::const_reference;
+    using reference = const_reference;
+    using const_pointer = typename vector_type::const_pointer;
+    using pointer = const_pointer;
+    // Elements cannot be modified through iterators, they are always const
+    using const_iterator = typename vector_type::const_iterator;
+    using iterator = const_iterator;
+    using const_reverse_iterator =
+        typename vector_type::const_reverse_iterator;
+    using reverse_iterator = const_reverse_iterator;
+
+    // CONSTRUCTORS
+
+    // Empty vector
+    aggregated_static_vector() = default;
+
+    // The elements of `vector`, with the aggregates computed on first use
+    explicit aggregated_static_vector(const vector_type& vector)
+        : m_vector(vector) {}
+    explicit aggregated_static_vector(vector_type&& vector) noexcept(
+        std::is_nothrow_move_constructible<vector_type>::value)
+        : m_vector(std::move(vector)) {}
+
+    // Initializer list constructor
+    aggregated_static_vector(std::initializer_list<value_type> init_list)
+        : m_vector(init_list) {}
+
+    // ELEMENT ACCESS
+
+    const_reference at(size_type index) const { return m_vector.at(index); }
+    const_reference operator[](size_type index) const noexcept {
+        return m_vector[index];
+    }
+    const_reference front() const noexcept { return m_vector.front(); }
+    const_reference back() const noexcept { return m_vector.back(); }
+    const_pointer data() const noexcept { return m_vector.data(); }
+
+    // The underlying static_vector
+    const vector_type& vector() const noexcept { return m_vector; }
+
+    // ITERATORS
+
+    const_iterator begin() const noexcept { return m_vector.begin(); }
+    const_iterator end() const noexcept { return m_vector.end(); }
+    const_iterator cbegin() const noexcept { return m_vector.cbegin(); }
+    const_iterator cend() const noexcept { return m_vector.cend(); }
+    const_reverse_iterator rbegin() const noexcept { return m_vector.rbegin(); }
+    const_reverse_iterator rend() const noexcept { return m_vector.rend(); }
+
+    // CAPACITY
+
+    size_type size() const noexcept { return m_vector.size(); }
+    bool empty() const noexcept { return m_vector.empty(); }
+    bool full() const noexcept { return m_vector.full(); }
+    size_type capacity() const noexcept { return m_vector.capacity(); }
+    size_type max_size() const noexcept { return m_vector.max_size(); }
+
+    // AGGREGATES
+
+    // The aggregate of the elements, Aggregate::identity() if empty
+    // Complexity: constant after push_back, pop_back and clear, O(size() -
+    // index) after an insert or erase at `index`
+    aggregate_type aggregate() const {
+        if (m_vector.empty())
+            return Aggregate::identity();
+        for (; m_valid < m_vector.size(); ++m_valid)
+            m_prefix[m_valid] = Aggregate::combine(
+                m_valid == 0 ? Aggregate::identity() : m_prefix[m_valid - 1],
+                m_vector[m_valid]);
+        return m_prefix[m_vector.size() - 1];
+    }
+
+    // MODIFIERS
+
+    // The modifiers have the exceptions of the static_vector functions they
+    // call. An exception from Aggregate::combine in push_back leaves the new
+    // element's prefix dirty, to be recomputed by aggregate().
+
+    // Complexity: constant, and one Aggregate::combine if the prefixes are
+    // up to date
+    void push_back(const value_type& value) {
+        m_vector.push_back(value);
+        combine_back();
+    }
+    void push_back(value_type&& value) {
+        m_vector.push_back(std::move(value));
+        combine_back();
+    }
+    template <typename... CtorArgs>
+    const_reference emplace_back(CtorArgs&&... args) {
+        m_vector.emplace_back(std::forward<CtorArgs>(args)...);
+        combine_back();
+        return m_vector.back();
+    }
+
+    // Requires: !empty()
+    // Complexity: constant
+    void pop_back() noexcept(
+        std::is_nothrow_destructible<value_type>::value) {
+        m_vector.pop_back();
+        forget_from(m_vector.size());
+    }
+
+    // Complexity: O(end() - pos) moves, the aggregate is recomputed lazily
+    const_iterator insert(const_iterator pos, const value_type& value) {
+        forget_from(static_cast<size_type>(pos - begin()));
+        return m_vector.insert(pos, value);
+    }
+    const_iterator insert(const_iterator pos, value_type&& value) {
+        forget_from(static_cast<size_type>(pos - begin()));
+        return m_vector.insert(pos, std::move(value));
+    }
+
+    // Complexity: O(end() - pos) moves, the aggregate is recomputed lazily
+    const_iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+    const_iterator erase(const_iterator first, const_iterator last) {
+        forget_from(static_cast<size_type>(first - begin()));
+        return m_vector.erase(first, last);
+    }
+
+    // Complexity: O(size()) for non-trivially destructible value_type,
+    // otherwise constant
+    void clear() noexcept(std::is_nothrow_destructible<value_type>::value) {
+        m_vector.clear();
+        m_valid = 0;
+    }
+
+private:
+    vector_type m_vector;
+    // m_prefix[i] is the aggregate of the first i + 1 elements for i <
+    // m_valid, the others are dirty
+    mutable std::array<aggregate_type, Capacity> m_prefix{};
+    mutable size_type m_valid = 0;
+
+    // Extend the prefixes to the last element if they are up to date
+    void combine_back() {
+        const size_type last = m_vector.size() - 1;
+        if (m_valid != last)
+            return;
+        m_prefix[last] = Aggregate::combine(
+            last == 0 ? Aggregate::identity() : m_prefix[last - 1],
+            m_vector[last]);
+        m_valid = m_vector.size();
+    }
+
+    // Mark the prefixes that include the element at `index` dirty
+    void forget_from(size_type index) noexcept {
+        m_valid = std::min(m_valid, index);
+    }
+};
+
+} // namespace stlpb
+
+#endif // PALOTASB_STATIC_VECTOR_AGGREGATED_H
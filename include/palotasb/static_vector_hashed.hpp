@@ -0,0 +1,316 @@
+#ifndef PALOTASB_STATIC_VECTOR_HASHED_H
+#define PALOTASB_STATIC_VECTOR_HASHED_H
+
+#pragma once
+
+/** Copyrighted according to the LICENSE file.
+ * SPDX-License-Identifier: MIT
+ * */
+
+#include <palotasb/static_vector.hpp>
+
+#include <cstddef>          // std::size_t
+#include <cstdint>          // std::uint64_t
+#include <functional>       // std::hash
+#include <initializer_list> // std::initializer_list
+#include <type_traits>      // std::is_nothrow_move_constructible
+#include <utility>          // std::move, std::forward, std::swap
+
+/** A static_vector that keeps a hash of its elements up to date as they are
+ * added and removed, for keys that are hashed and compared often.
+ *
+ * The hash is the polynomial sum of h(x[i]) * B^i modulo 2^64 over the
+ * elements, where h mixes std::hash<T> of an element and B is an odd
+ * constant. The vector also keeps B^size(), so push_back and pop_back add
+ * or subtract one term with a few multiplications. insert and erase
+ * recompute the terms of the elements they shift, which they move anyway.
+ * std::hash is then constant time, and == and != compare the sizes and
+ * hashes before any element, so unequal vectors are almost always told apart
+ * in constant time.
+ *
+ * Only the operations that keep the hash up to date are available: the
+ * elements can be read but not modified in place. vector() gives the
+ * underlying static_vector for everything else that reads.
+ * */
+
+namespace stlpb {
+
+namespace detail {
+
+// The base B of the polynomial hash of hashed_static_vector
+constexpr std::uint64_t rolling_hash_base = 0xff51afd7ed558ccdull;
+
+// B^-1 modulo 2^64, which exists because B is odd. Each Newton step doubles
+// the number of correct low bits, starting from 3.
+constexpr std::uint64_t rolling_hash_inverse() noexcept {
+    std::uint64_t inverse = rolling_hash_base;
+    for (int i = 0; i < 5; ++i)
+        inverse *= 2 - rolling_hash_base * inverse;
+    return inverse;
+}
+static_assert(
+    rolling_hash_base * rolling_hash_inverse() == 1, "B * B^-1 == 1");
+
+// B^exponent modulo 2^64, by squaring
+inline std::uint64_t rolling_hash_power(std::size_t exponent) noexcept {
+    std::uint64_t result = 1;
+    std::uint64_t base = rolling_hash_base;
+    for (; exponent != 0; exponent >>= 1) {
+        if (exponent & 1)
+            result *= base;
+        base *= base;
+    }
+    return result;
+}
+
+// std::hash<T> of `value` with its bits mixed, because std::hash of
+// integers is often the identity
+template <typename T>
+std::uint64_t rolling_hash_element(const T& value) noexcept(
+    noexcept(std::hash<T>{}(value))) {
+    std::uint64_t hash = std::hash<T>{}(value);
+    hash *= 0x9e3779b97f4a7c15ull;
+    return hash ^ (hash >> 32);
+}
+
+// The hash terms of the elements [first, last), the first of which is at
+// index `index`
+template <typename Iter>
+std::uint64_t rolling_hash_terms(Iter first, Iter last, std::size_t index) {
+    std::uint64_t power = rolling_hash_power(index);
+    std::uint64_t sum = 0;
+    for (; first != last; ++first) {
+        sum += rolling_hash_element(*first) * power;
+        power *= rolling_hash_base;
+    }
+    return sum;
+}
+
+} // namespace detail
+
+template <
+    typename T, std::size_t Capacity,
+    typename Policy = static_vector_policy>
+class hashed_static_vector {
+public:
+    // MEMBER TYPES
+
+    using vector_type = static_vector<T, Capacity, Policy>;
+    using value_type = typename vector_type::value_type;
+    using size_type = typename vector_type::size_type;
+    using difference_type = typename vector_type::difference_type;
+    using const_reference = typename vector_type::const_reference;
+    using reference = const_reference;
+    using const_pointer = typename vector_type::const_pointer;
+    using pointer = const_pointer;
+    // Elements cannot be modified through iterators, they are always const
+    using const_iterator = typename vector_type::const_iterator;
+    using iterator = const_iterator;
+    using const_reverse_iterator =
+        typename vector_type::const_reverse_iterator;
+    using reverse_iterator = const_reverse_iterator;
+
+    // CONSTRUCTORS
+
+    // Empty vector
+    hashed_static_vector() noexcept = default;
+
+    // The elements of `vector`
+    // Complexity: O(vector.size())
+    explicit hashed_static_vector(const vector_type& vector)
+        : m_vector(vector) {
+        rehash();
+    }
+    explicit hashed_static_vector(vector_type&& vector) noexcept(
+        std::is_nothrow_move_constructible<vector_type>::value)
+        : m_vector(std::move(vector)) {
+        rehash();
+    }
+
+    // Initializer list constructor
+    hashed_static_vector(std::initializer_list<value_type> init_list)
+        : m_vector(init_list) {
+        rehash();
+    }
+
+    // ELEMENT ACCESS
+
+    const_reference at(size_type index) const { return m_vector.at(index); }
+    const_reference operator[](size_type index) const noexcept {
+        return m_vector[index];
+    }
+    const_reference front() const noexcept { return m_vector.front(); }
+    const_reference back() const noexcept { return m_vector.back(); }
+    const_pointer data() const noexcept { return m_vector.data(); }
+
+    // The underlying static_vector
+    const vector_type& vector() const noexcept { return m_vector; }
+
+    // ITERATORS
+
+    const_iterator begin() const noexcept { return m_vector.begin(); }
+    const_iterator end() const noexcept { return m_vector.end(); }
+    const_iterator cbegin() const noexcept { return m_vector.cbegin(); }
+    const_iterator cend() const noexcept { return m_vector.cend(); }
+    const_reverse_iterator rbegin() const noexcept { return m_vector.rbegin(); }
+    const_reverse_iterator rend() const noexcept { return m_vector.rend(); }
+
+    // CAPACITY
+
+    size_type size() const noexcept { return m_vector.size(); }
+    bool empty() const noexcept { return m_vector.empty(); }
+    bool full() const noexcept { return m_vector.full(); }
+    size_type capacity() const noexcept { return m_vector.capacity(); }
+    size_type max_size() const noexcept { return m_vector.max_size(); }
+
+    // HASH
+
+    // The hash of the elements, equal for equal vectors
+    // Complexity: constant
+    std::size_t hash() const noexcept {
+        return static_cast<std::size_t>(
+            m_hash ^ (m_vector.size() * 0x9e3779b97f4a7c15ull));
+    }
+
+    // MODIFIERS
+
+    // The modifiers have the exceptions of the static_vector functions they
+    // call. The hash is updated after the elements change, so an exception
+    // leaves both as they were.
+
+    // Complexity: constant, and one std::hash<T>
+    void push_back(const value_type& value) {
+        m_vector.push_back(value);
+        add_back();
+    }
+    void push_back(value_type&& value) {
+        m_vector.push_back(std::move(value));
+        add_back();
+    }
+    template <typename... CtorArgs>
+    const_reference emplace_back(CtorArgs&&... args) {
+        m_vector.emplace_back(std::forward<CtorArgs>(args)...);
+        add_back();
+        return m_vector.back();
+    }
+
+    // Requires: !empty()
+    // Complexity: constant, and one std::hash<T>
+    void pop_back() {
+        const std::uint64_t power = m_power * detail::rolling_hash_inverse();
+        m_hash -= detail::rolling_hash_element(m_vector.back()) * power;
+        m_vector.pop_back();
+        m_power = power;
+    }
+
+    // Complexity: O(end() - pos) moves and std::hash<T>
+    const_iterator insert(const_iterator pos, const value_type& value) {
+        return insert_one(pos, value);
+    }
+    const_iterator insert(const_iterator pos, value_type&& value) {
+        return insert_one(pos, std::move(value));
+    }
+
+    // Complexity: O(end() - pos) moves and std::hash<T>
+    const_iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+    const_iterator erase(const_iterator first, const_iterator last) {
+        const size_type index = static_cast<size_type>(first - begin());
+        const std::uint64_t removed =
+            detail::rolling_hash_terms(first, end(), index);
+        const const_iterator result = m_vector.erase(first, last);
+        m_hash = m_hash - removed +
+                 detail::rolling_hash_terms(result, end(), index);
+        m_power = detail::rolling_hash_power(size());
+        return result;
+    }
+
+    // Complexity: O(size()) for non-trivially destructible value_type,
+    // otherwise constant
+    void clear() noexcept(noexcept(std::declval<vector_type&>().clear())) {
+        m_vector.clear();
+        m_hash = 0;
+        m_power = 1;
+    }
+
+    void swap(hashed_static_vector& other) noexcept(
+        noexcept(std::declval<vector_type&>().swap(other.m_vector))) {
+        m_vector.swap(other.m_vector);
+        std::swap(m_hash, other.m_hash);
+        std::swap(m_power, other.m_power);
+    }
+
+private:
+    vector_type m_vector;
+    std::uint64_t m_hash = 0;
+    // B^size()
+    std::uint64_t m_power = 1;
+
+    void rehash() {
+        m_hash = detail::rolling_hash_terms(begin(), end(), 0);
+        m_power = detail::rolling_hash_power(size());
+    }
+
+    // Add the term of the last element
+    void add_back() {
+        m_hash += detail::rolling_hash_element(m_vector.back()) * m_power;
+        m_power *= detail::rolling_hash_base;
+    }
+
+    // The elements from `pos` move up one index, which multiplies their
+    // terms by B
+    template <typename U>
+    const_iterator insert_one(const_iterator pos, U&& value) {
+        const size_type index = static_cast<size_type>(pos - begin());
+        const std::uint64_t shifted =
+            detail::rolling_hash_terms(pos, end(), index);
+        const const_iterator result =
+            m_vector.insert(pos, std::forward<U>(value));
+        m_hash += shifted * (detail::rolling_hash_base - 1) +
+                  detail::rolling_hash_element(*result) *
+                      detail::rolling_hash_power(index);
+        m_power *= detail::rolling_hash_base;
+        return result;
+    }
+};
+
+// Equality: equal sizes and hashes first, then equal elements
+// Complexity: constant if the sizes or hashes differ, otherwise O(size())
+template <typename T, std::size_t Capacity, typename Policy>
+bool operator==(
+    const hashed_static_vector<T, Capacity, Policy>& a,
+    const hashed_static_vector<T, Capacity, Policy>& b) {
+    return a.size() == b.size() && a.hash() == b.hash() &&
+           a.vector() == b.vector();
+}
+template <typename T, std::size_t Capacity, typename Policy>
+bool operator!=(
+    const hashed_static_vector<T, Capacity, Policy>& a,
+    const hashed_static_vector<T, Capacity, Policy>& b) {
+    return !(a == b);
+}
+
+template <typename T, std::size_t Capacity, typename Policy>
+void swap(
+    hashed_static_vector<T, Capacity, Policy>& a,
+    hashed_static_vector<T, Capacity, Policy>& b) //
+    noexcept(noexcept(a.swap(b))) {
+    a.swap(b);
+}
+
+} // namespace stlpb
+
+namespace std {
+
+// The maintained hash, see hashed_static_vector::hash()
+template <typename T, std::size_t Capacity, typename Policy>
+struct hash<stlpb::hashed_static_vector<T, Capacity, Policy>> {
+    std::size_t operator()(
+        const stlpb::hashed_static_vector<T, Capacity, Policy>& v) const
+        noexcept {
+        return v.hash();
+    }
+};
+
+} // namespace std
+
+#endif // PALOTASB_STATIC_VECTOR_HASHED_H
@@ -0,0 +1,331 @@
+#ifndef PALOTASB_STATIC_VECTOR_IO_H
+#define PALOTASB_STATIC_VECTOR_IO_H
+
+#pragma once
+
+/** Copyrighted according to the LICENSE file.
+ * SPDX-License-Identifier: MIT
+ * */
+
+#include <palotasb/static_vector.hpp>
+
+#include <algorithm>    // std::min
+#include <cerrno>       // errno, EINTR
+#include <climits>      // IOV_MAX
+#include <cstddef>      // std::size_t
+#include <cstdio>       // std::FILE, std::fread
+#include <limits>       // std::numeric_limits
+#include <system_error> // std::system_error
+#include <type_traits>  // std::is_trivially_copyable
+
+#include <sys/types.h> // off_t, ssize_t
+#include <sys/uio.h>   // iovec, readv, writev
+#include <unistd.h>    // read, pread
+
+/** Reading bytes from files straight into the unused slots of a static_vector
+ * of a byte type such as char, POSIX only.
+ *
+ * Reading into a local buffer and appending it copies every byte twice. These
+ * functions let read(2), pread(2) or std::fread write into the slots past the
+ * size instead, with static_vector_ref::resize_and_overwrite, and add the
+ * bytes read to the size. They read at most `max` bytes and never more than
+ * fit, so a full vector reads nothing.
+ *
+ * Reads interrupted by a signal (EINTR) are restarted. Other errors throw
+ * std::system_error after the bytes read before them are appended.
+ *
+ * For scatter/gather I/O, static_iovec_builder collects the pieces of a
+ * message as iovec entries, and writev_all and readv_all transfer a
+ * static_vector of iovecs with as few system calls as possible, continuing
+ * after partial transfers in place, without copying the pieces into one
+ * buffer first.
+ * */
+
+namespace stlpb {
+
+namespace detail {
+
+template <typename T> struct check_io_element {
+    static_assert(sizeof(T) == 1 && std::is_trivially_copyable<T>::value,
+                  "static_vector I/O requires a byte element type");
+};
+
+// Append up to `max` bytes with `read_some(buffer, count, offset)`, a read(2)
+// like function where `offset` is the number of bytes appended before, until
+// `max` bytes are appended, the vector is full or it returns 0, or after the
+// first successful call unless `all`
+// Returns: the number of bytes appended
+template <typename T, typename ReadSome>
+std::size_t append_bytes(static_vector_ref<T>& vector, std::size_t max,
+                         bool all, ReadSome read_some, const char* what) {
+    check_io_element<T>{};
+    const std::size_t old_size = vector.size();
+    int error = 0;
+    vector.resize_and_overwrite(
+        old_size + std::min(max, vector.capacity() - old_size),
+        [&](T* data, std::size_t count) {
+            std::size_t size = old_size;
+            while (size < count) {
+                const ssize_t n = read_some(static_cast<void*>(data + size),
+                                            count - size, size - old_size);
+                if (n > 0) {
+                    size += static_cast<std::size_t>(n);
+                    if (!all)
+                        break;
+                } else if (n == 0) {
+                    break;
+                } else if (errno != EINTR) {
+                    error = errno;
+                    break;
+                }
+            }
+            return size;
+        });
+    if (error != 0)
+        throw std::system_error(error, std::generic_category(), what);
+    return vector.size() - old_size;
+}
+
+// The number of iovec entries a readv(2) or writev(2) call accepts, at least
+// the POSIX minimum
+#ifdef IOV_MAX
+constexpr std::size_t iov_max = IOV_MAX;
+#else
+constexpr std::size_t iov_max = 16;
+#endif
+
+// Skip the `count` bytes transferred from the entries of `buffers` starting
+// at `first`, and the empty entries after them, by moving `first` past the
+// entries transferred completely and advancing the base of a partially
+// transferred one
+inline void consume_iovecs(static_vector_ref<iovec>& buffers,
+                           std::size_t& first, std::size_t count) noexcept {
+    for (; first < buffers.size() && buffers[first].iov_len <= count;
+         ++first)
+        count -= buffers[first].iov_len;
+    if (count != 0) {
+        buffers[first].iov_base = static_cast<char*>(buffers[first].iov_base) +
+                                  count;
+        buffers[first].iov_len -= count;
+    }
+}
+
+// Transfer the entries of `buffers` with `transfer(iov, iovcnt)`, a
+// readv(2) like function, until all are transferred or it returns 0, and
+// erase the ones transferred completely
+// Returns: the number of bytes transferred
+template <typename Transfer>
+std::size_t transfer_iovecs(static_vector_ref<iovec>& buffers,
+                            Transfer transfer, const char* what) {
+    std::size_t first = 0;
+    std::size_t total = 0;
+    int error = 0;
+    consume_iovecs(buffers, first, 0);
+    while (first < buffers.size()) {
+        const ssize_t n = transfer(
+            buffers.data() + first,
+            static_cast<int>(std::min(buffers.size() - first, iov_max)));
+        if (n > 0) {
+            total += static_cast<std::size_t>(n);
+            consume_iovecs(buffers, first, static_cast<std::size_t>(n));
+        } else if (n == 0) {
+            break;
+        } else if (errno != EINTR) {
+            error = errno;
+            break;
+        }
+    }
+    buffers.erase(buffers.begin(),
+                  buffers.begin() + static_cast<std::ptrdiff_t>(first));
+    if (error != 0)
+        throw std::system_error(error, std::generic_category(), what);
+    return total;
+}
+
+} // namespace detail
+
+// Append the bytes of one read(2) from `fd`, at most `max` of them, e.g. the
+// data available on a socket or pipe
+// Returns: the number of bytes appended, 0 at end of file or if full()
+// Exceptions: std::system_error if read(2) fails
+template <typename T>
+std::size_t
+append_some_from_fd(static_vector_ref<T>& vector, int fd,
+                    std::size_t max = std::numeric_limits<std::size_t>::max()) {
+    return detail::append_bytes(
+        vector, max, false,
+        [fd](void* buffer, std::size_t count, std::size_t) {
+            return ::read(fd, buffer, count);
+        },
+        "read");
+}
+
+// Append bytes read from `fd` until `max` bytes are appended, the vector is
+// full or the end of the file, continuing after short reads
+// Returns: the number of bytes appended
+// Exceptions: std::system_error if read(2) fails
+template <typename T>
+std::size_t
+append_from_fd(static_vector_ref<T>& vector, int fd,
+               std::size_t max = std::numeric_limits<std::size_t>::max()) {
+    return detail::append_bytes(
+        vector, max, true,
+        [fd](void* buffer, std::size_t count, std::size_t) {
+            return ::read(fd, buffer, count);
+        },
+        "read");
+}
+
+// Append bytes read with pread(2) from `offset` in `fd` like
+// append_from_fd, without moving the file offset of `fd`
+// Returns: the number of bytes appended
+// Exceptions: std::system_error if pread(2) fails
+template <typename T>
+std::size_t
+append_from_fd_at(static_vector_ref<T>& vector, int fd, off_t offset,
+                  std::size_t max = std::numeric_limits<std::size_t>::max()) {
+    return detail::append_bytes(
+        vector, max, true,
+        [fd, offset](void* buffer, std::size_t count, std::size_t read) {
+            return ::pread(fd, buffer, count,
+                           offset + static_cast<off_t>(read));
+        },
+        "pread");
+}
+
+// Append bytes read from `file` with std::fread until `max` bytes are
+// appended, the vector is full or the end of the file
+// Returns: the number of bytes appended
+// Exceptions: std::system_error if std::fread fails
+template <typename T>
+std::size_t
+append_from(static_vector_ref<T>& vector, std::FILE* file,
+            std::size_t max = std::numeric_limits<std::size_t>::max()) {
+    return detail::append_bytes(
+        vector, max, true,
+        [file](void* buffer, std::size_t count, std::size_t) -> ssize_t {
+            const std::size_t n = std::fread(buffer, 1, count, file);
+            if (n == 0 && std::ferror(file)) {
+                std::clearerr(file);
+                return -1;
+            }
+            return static_cast<ssize_t>(n);
+        },
+        "fread");
+}
+
+// Write the buffers of `buffers` to `fd` with writev(2), continuing after
+// partial writes, and erase them. The entries are written in place: the one
+// written partially when an error is thrown is advanced past the bytes
+// written, so calling writev_all again, e.g. after EAGAIN on a non-blocking
+// `fd`, writes the rest.
+// Returns: the number of bytes written
+// Exceptions: std::system_error if writev(2) fails, which leaves the entries
+// not written completely
+inline std::size_t writev_all(int fd, static_vector_ref<iovec>& buffers) {
+    return detail::transfer_iovecs(
+        buffers,
+        [fd](const iovec* iov, int count) { return ::writev(fd, iov, count); },
+        "writev");
+}
+
+// Fill the buffers of `buffers` from `fd` with readv(2) until they are full
+// or the end of the file, continuing after short reads, and erase the ones
+// filled completely, like writev_all
+// Returns: the number of bytes read
+// Exceptions: std::system_error if readv(2) fails, which leaves the entries
+// not filled completely
+inline std::size_t readv_all(int fd, static_vector_ref<iovec>& buffers) {
+    return detail::transfer_iovecs(
+        buffers,
+        [fd](const iovec* iov, int count) { return ::readv(fd, iov, count); },
+        "readv");
+}
+
+// The pieces of a message to write with one writev(2), up to `Count` iovec
+// entries, and `InlineBytes` bytes of inline storage for small pieces such as
+// headers and separators that are copied instead of referenced.
+// Pieces that continue the previous one in memory extend its entry.
+// The kernel copies the pieces one entry at a time, so referencing instead of
+// copying pays off for pieces of several KiB; copying smaller ones with
+// append_copy keeps the number of entries down.
+// The entries point into the builder, so it is neither copyable nor movable.
+template <std::size_t Count, std::size_t InlineBytes = 0>
+class static_iovec_builder {
+public:
+    static_iovec_builder() = default;
+    static_iovec_builder(const static_iovec_builder&) = delete;
+    static_iovec_builder& operator=(const static_iovec_builder&) = delete;
+
+    // Append a reference to the `size` bytes at `data`, which must stay
+    // valid until they are written
+    // Complexity: constant
+    // Exceptions: std::out_of_range if a new entry does not fit
+    void append(const void* data, std::size_t size) {
+        if (!m_entries.empty() &&
+            static_cast<const char*>(m_entries.back().iov_base) +
+                    m_entries.back().iov_len ==
+                data) {
+            m_entries.back().iov_len += size;
+            return;
+        }
+        m_entries.push_back(iovec{const_cast<void*>(data), size});
+    }
+    // Append a reference to the bytes of a contiguous container, e.g. an
+    // std::string or a static_vector<char, N>
+    template <typename Bytes> void append(const Bytes& bytes) {
+        append(bytes.data(), bytes.size() * sizeof(*bytes.data()));
+    }
+
+    // Append a copy of the `size` bytes at `data` in the inline storage
+    // Complexity: O(size)
+    // Exceptions: std::out_of_range if the bytes or a new entry do not fit,
+    // which leaves the builder unchanged
+    void append_copy(const void* data, std::size_t size) {
+        auto guard = m_inline.scoped_checkpoint();
+        const char* bytes = static_cast<const char*>(data);
+        m_inline.insert(m_inline.end(), bytes, bytes + size);
+        append(m_inline.data() + guard.mark().size, size);
+        guard.commit();
+    }
+
+    // The entries, for writev_all or readv_all
+    static_vector_ref<iovec>& entries() noexcept { return m_entries; }
+    const static_vector_ref<iovec>& entries() const noexcept {
+        return m_entries;
+    }
+
+    // The number of bytes to write
+    // Complexity: O(entries().size())
+    std::size_t bytes() const noexcept {
+        std::size_t result = 0;
+        for (const iovec& entry : m_entries)
+            result += entry.iov_len;
+        return result;
+    }
+
+    // Write the message to `fd` with writev_all, which clears the builder
+    // once all of it is written
+    // Returns: the number of bytes written
+    // Exceptions: std::system_error if writev(2) fails, which leaves the
+    // rest of the message to write
+    std::size_t write_to(int fd) {
+        const std::size_t written = writev_all(fd, m_entries);
+        if (m_entries.empty())
+            m_inline.clear();
+        return written;
+    }
+
+    void clear() noexcept {
+        m_entries.clear();
+        m_inline.clear();
+    }
+
+private:
+    static_vector<iovec, Count> m_entries;
+    static_vector<char, InlineBytes> m_inline;
+};
+
+} // namespace stlpb
+
+#endif // PALOTASB_STATIC_VECTOR_IO_H
@@ -0,0 +1,188 @@
+#ifndef PALOTASB_STATIC_VECTOR_OBSERVERS_H
+#define PALOTASB_STATIC_VECTOR_OBSERVERS_H
+
+#pragma once
+
+/** Copyrighted according to the LICENSE file.
+ * SPDX-License-Identifier: MIT
+ * */
+
+#include <palotasb/static_vector.hpp>
+
+#include <cstddef> // std::size_t
+
+#if defined(__has_include)
+#if __has_include(<sys/sdt.h>)
+#include <sys/sdt.h> // STAP_PROBE*
+#define PALOTASB_STATIC_VECTOR_HAVE_SDT 1
+#endif
+#endif
+
+/** Ready-made observers of static_vector operations, see null_observer. They
+ * are selected with the `observer` member type of a Policy and only called
+ * if PALOTASB_STATIC_VECTOR_OBSERVE is defined:
+ *
+ *   struct counted_policy : stlpb::static_vector_policy {
+ *       using observer = stlpb::counting_observer;
+ *   };
+ *   stlpb::static_vector<int, 16, counted_policy> v;
+ * */
+
+namespace stlpb {
+
+// Event counts of one thread, see counting_observer
+struct observer_counts {
+    std::size_t constructs = 0;
+    std::size_t grows = 0;
+    std::size_t shrinks = 0;
+    std::size_t overflows = 0;
+    // Number of insert and erase calls that moved elements, and the total
+    // number of elements they moved
+    std::size_t shifts = 0;
+    std::size_t shifted_elements = 0;
+    // fill[i] counts the times the size grew to between i / 10 and
+    // (i + 1) / 10 of the capacity, fill[10] the times it became full
+    std::size_t fill[11] = {};
+};
+
+// Observer counting the events of the calling thread in thread_local
+// counters, without any synchronization
+struct counting_observer : null_observer {
+    // The counts of the calling thread
+    static observer_counts& counts() noexcept {
+        static thread_local observer_counts thread_counts;
+        return thread_counts;
+    }
+
+    static void construct(std::size_t /*capacity*/) noexcept {
+        counts().constructs++;
+    }
+    static void grow(std::size_t size, std::size_t capacity) noexcept {
+        observer_counts& c = counts();
+        c.grows++;
+        c.fill[size * 10 / capacity]++;
+    }
+    static void
+    shrink(std::size_t /*size*/, std::size_t /*capacity*/) noexcept {
+        counts().shrinks++;
+    }
+    static void shift(std::size_t count) noexcept {
+        observer_counts& c = counts();
+        c.shifts++;
+        c.shifted_elements += count;
+    }
+    static void overflow(std::size_t /*capacity*/) noexcept {
+        counts().overflows++;
+    }
+};
+
+// Markers of the events that perf, bpftrace or SystemTap can attach to. With
+// <sys/sdt.h> they are USDT probes in the `palotasb_static_vector` provider,
+// e.g. `perf probe sdt_palotasb_static_vector:overflow`, which are a single
+// nop while nothing is attached. Otherwise they are calls to the
+// non-inlined extern "C" functions palotasb_static_vector_<event>, for
+// uprobes, e.g. `perf probe -x app palotasb_static_vector_overflow`.
+struct trace_observer : null_observer {
+    static void construct(std::size_t capacity) noexcept;
+    static void grow(std::size_t size, std::size_t capacity) noexcept;
+    static void shrink(std::size_t size, std::size_t capacity) noexcept;
+    static void shift(std::size_t count) noexcept;
+    static void overflow(std::size_t capacity) noexcept;
+};
+
+} // namespace stlpb
+
+#ifdef PALOTASB_STATIC_VECTOR_HAVE_SDT
+
+namespace stlpb {
+
+inline void trace_observer::construct(std::size_t capacity) noexcept {
+    STAP_PROBE1(palotasb_static_vector, construct, capacity);
+}
+inline void
+trace_observer::grow(std::size_t size, std::size_t capacity) noexcept {
+    STAP_PROBE2(palotasb_static_vector, grow, size, capacity);
+}
+inline void
+trace_observer::shrink(std::size_t size, std::size_t capacity) noexcept {
+    STAP_PROBE2(palotasb_static_vector, shrink, size, capacity);
+}
+inline void trace_observer::shift(std::size_t count) noexcept {
+    STAP_PROBE1(palotasb_static_vector, shift, count);
+}
+inline void trace_observer::overflow(std::size_t capacity) noexcept {
+    STAP_PROBE1(palotasb_static_vector, overflow, capacity);
+}
+
+} // namespace stlpb
+
+#else
+
+#if defined(__GNUC__)
+#define PALOTASB_STATIC_VECTOR_NOINLINE __attribute__((noinline))
+#elif defined(_MSC_VER)
+#define PALOTASB_STATIC_VECTOR_NOINLINE __declspec(noinline)
+#else
+#define PALOTASB_STATIC_VECTOR_NOINLINE
+#endif
+
+// The empty asm statements keep the compiler from removing the calls
+#if defined(__GNUC__)
+#define PALOTASB_STATIC_VECTOR_MARKER() asm volatile("")
+#else
+#define PALOTASB_STATIC_VECTOR_MARKER()
+#endif
+
+extern "C" {
+
+PALOTASB_STATIC_VECTOR_NOINLINE inline void
+palotasb_static_vector_construct(std::size_t /*capacity*/) noexcept {
+    PALOTASB_STATIC_VECTOR_MARKER();
+}
+PALOTASB_STATIC_VECTOR_NOINLINE inline void palotasb_static_vector_grow(
+    std::size_t /*size*/, std::size_t /*capacity*/) noexcept {
+    PALOTASB_STATIC_VECTOR_MARKER();
+}
+PALOTASB_STATIC_VECTOR_NOINLINE inline void palotasb_static_vector_shrink(
+    std::size_t /*size*/, std::size_t /*capacity*/) noexcept {
+    PALOTASB_STATIC_VECTOR_MARKER();
+}
+PALOTASB_STATIC_VECTOR_NOINLINE inline void
+palotasb_static_vector_shift(std::size_t /*count*/) noexcept {
+    PALOTASB_STATIC_VECTOR_MARKER();
+}
+PALOTASB_STATIC_VECTOR_NOINLINE inline void
+palotasb_static_vector_overflow(std::size_t /*capacity*/) noexcept {
+    PALOTASB_STATIC_VECTOR_MARKER();
+}
+
+} // extern "C"
+
+namespace stlpb {
+
+inline void trace_observer::construct(std::size_t capacity) noexcept {
+    palotasb_static_vector_construct(capacity);
+}
+inline void
+trace_observer::grow(std::size_t size, std::size_t capacity) noexcept {
+    palotasb_static_vector_grow(size, capacity);
+}
+inline void
+trace_observer::shrink(std::size_t size, std::size_t capacity) noexcept {
+    palotasb_static_vector_shrink(size, capacity);
+}
+inline void trace_observer::shift(std::size_t count) noexcept {
+    palotasb_static_vector_shift(count);
+}
+inline void trace_observer::overflow(std::size_t capacity) noexcept {
+    palotasb_static_vector_overflow(capacity);
+}
+
+} // namespace stlpb
+
+#undef PALOTASB_STATIC_VECTOR_MARKER
+#undef PALOTASB_STATIC_VECTOR_NOINLINE
+
+#endif // PALOTASB_STATIC_VECTOR_HAVE_SDT
+
+#endif // PALOTASB_STATIC_VECTOR_OBSERVERS_H
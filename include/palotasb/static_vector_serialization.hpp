@@ -0,0 +1,246 @@
+#ifndef PALOTASB_STATIC_VECTOR_SERIALIZATION_H
+#define PALOTASB_STATIC_VECTOR_SERIALIZATION_H
+
+#pragma once
+
+/** Copyrighted according to the LICENSE file.
+ * SPDX-License-Identifier: MIT
+ * */
+
+#include <palotasb/static_vector.hpp>
+
+#include <cstddef>     // std::size_t, std::byte
+#include <cstdint>     // std::uint8_t, std::uint32_t, std::uint64_t
+#include <cstring>     // std::memcpy
+#include <stdexcept>   // std::invalid_argument
+#include <type_traits> // std::is_trivially_copyable, std::integral_constant
+
+#if __cplusplus >= 202002L
+#include <span> // std::span
+#endif
+
+/** A binary format for static_vectors: a 16 byte header followed by the
+ * elements.
+ *
+ *   offset  size  contents
+ *   0       1     tag: the width of the count in bytes, 8, plus 0x80 for
+ *                 big-endian byte order
+ *   1       3     zero
+ *   4       4     the size of the elements in bytes, or 0 if they are
+ *                 serialized one by one
+ *   8       8     the number of elements
+ *   16            the elements
+ *
+ * The numbers are in the byte order of the tag. The elements of trivially
+ * copyable types are their object representations, so they are written and
+ * read with a single memcpy; the format is meant for exchanging vectors
+ * between builds of the same ABI, and reading rejects another byte order or
+ * element size. Trivially copyable types that do not accept every object
+ * representation, such as bool or enums, must only be read from trusted data.
+ *
+ * Elements of other types are serialized one after the other with the
+ * serialized_size, serialize_into and deserialize_from overloads found by
+ * argument-dependent lookup, so static_vectors of static_vectors work too.
+ * Such types need a default constructor to deserialize into.
+ *
+ * The buffers are passed as a pointer and a size, or as std::span<std::byte>
+ * in C++20.
+ * */
+
+namespace stlpb {
+
+namespace detail {
+
+constexpr std::size_t serialization_header_size = 16;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr std::uint8_t serialization_tag = 0x80 | sizeof(std::uint64_t);
+#else
+constexpr std::uint8_t serialization_tag = sizeof(std::uint64_t);
+#endif
+
+// The element size of the header, 0 for elements serialized one by one
+template <typename T> constexpr std::uint32_t serialized_element_size() {
+    return std::is_trivially_copyable<T>::value
+               ? static_cast<std::uint32_t>(sizeof(T))
+               : 0;
+}
+
+[[noreturn]] inline void throw_invalid_serialization(const char* what) {
+    throw std::invalid_argument(what);
+}
+
+inline void check_serialization_buffer(std::size_t needed, std::size_t size) {
+    if (size < needed)
+        throw_invalid_serialization(
+            "static_vector serialization: buffer too small");
+}
+
+template <typename T>
+std::size_t elements_serialized_size(const static_vector_ref<T>& vector,
+                                     std::true_type) noexcept {
+    return vector.size() * sizeof(T);
+}
+template <typename T>
+std::size_t elements_serialized_size(const static_vector_ref<T>& vector,
+                                     std::false_type) {
+    std::size_t result = 0;
+    for (const T& element : vector)
+        result += serialized_size(element);
+    return result;
+}
+
+template <typename T>
+std::size_t serialize_elements(const static_vector_ref<T>& vector,
+                               unsigned char* buffer, std::size_t,
+                               std::true_type) noexcept {
+    std::memcpy(buffer, vector.data(), vector.size() * sizeof(T));
+    return vector.size() * sizeof(T);
+}
+template <typename T>
+std::size_t serialize_elements(const static_vector_ref<T>& vector,
+                               unsigned char* buffer, std::size_t size,
+                               std::false_type) {
+    std::size_t written = 0;
+    for (const T& element : vector)
+        written += serialize_into(element, buffer + written, size - written);
+    return written;
+}
+
+// Copy the bytes of `count` elements at `buffer` into `vector`, without
+// constructing them first if they are trivial
+template <typename T>
+void overwrite_elements(static_vector_ref<T>& vector,
+                        const unsigned char* buffer, std::size_t count,
+                        std::true_type) {
+    vector.resize_and_overwrite(count, [&](T* data, std::size_t) {
+        std::memcpy(static_cast<void*>(data), buffer, count * sizeof(T));
+        return count;
+    });
+}
+template <typename T>
+void overwrite_elements(static_vector_ref<T>& vector,
+                        const unsigned char* buffer, std::size_t count,
+                        std::false_type) {
+    vector.resize(count, default_init);
+    std::memcpy(static_cast<void*>(vector.data()), buffer, count * sizeof(T));
+}
+
+template <typename T>
+std::size_t deserialize_elements(static_vector_ref<T>& vector,
+                                 const unsigned char* buffer,
+                                 std::size_t size, std::size_t count,
+                                 std::true_type) {
+    check_serialization_buffer(count * sizeof(T), size);
+    overwrite_elements(
+        vector, buffer, count,
+        std::integral_constant<
+            bool, std::is_trivially_default_constructible<T>::value &&
+                      std::is_trivially_destructible<T>::value>{});
+    return count * sizeof(T);
+}
+template <typename T>
+std::size_t deserialize_elements(static_vector_ref<T>& vector,
+                                 const unsigned char* buffer,
+                                 std::size_t size, std::size_t count,
+                                 std::false_type) {
+    vector.clear();
+    std::size_t read = 0;
+    for (std::size_t i = 0; i < count; ++i) {
+        vector.emplace_back();
+        read += deserialize_from(vector.back(), buffer + read, size - read);
+    }
+    return read;
+}
+
+} // namespace detail
+
+// The number of bytes serialize_into writes for `vector`
+// Complexity: constant for trivially copyable value_type, otherwise the sum
+// of the serialized_size of the elements
+template <typename T>
+std::size_t serialized_size(const static_vector_ref<T>& vector) {
+    return detail::serialization_header_size +
+           detail::elements_serialized_size(
+               vector, std::is_trivially_copyable<T>{});
+}
+
+// Write `vector` into the `size` bytes at `buffer` in the format above
+// Returns: the number of bytes written, serialized_size(vector)
+// Complexity: a memcpy of the elements for trivially copyable value_type,
+// otherwise serialize_into for each element
+// Exceptions: std::invalid_argument if the buffer is smaller than
+// serialized_size(vector)
+template <typename T>
+std::size_t serialize_into(const static_vector_ref<T>& vector, void* buffer,
+                           std::size_t size) {
+    using trivial = std::is_trivially_copyable<T>;
+    detail::check_serialization_buffer(detail::serialization_header_size,
+                                       size);
+    if (trivial::value)
+        detail::check_serialization_buffer(serialized_size(vector), size);
+    unsigned char header[detail::serialization_header_size] = {
+        detail::serialization_tag};
+    const std::uint32_t element_size = detail::serialized_element_size<T>();
+    const std::uint64_t count = vector.size();
+    std::memcpy(header + 4, &element_size, sizeof(element_size));
+    std::memcpy(header + 8, &count, sizeof(count));
+    unsigned char* bytes = static_cast<unsigned char*>(buffer);
+    std::memcpy(bytes, header, sizeof(header));
+    return sizeof(header) +
+           detail::serialize_elements(vector, bytes + sizeof(header),
+                                      size - sizeof(header), trivial{});
+}
+
+// Replace the elements of `vector` with the ones serialized at the start of
+// the `size` bytes at `buffer`
+// Returns: the number of bytes read
+// Complexity: a memcpy of the elements for trivially copyable value_type,
+// otherwise deserialize_from for each element
+// Exceptions: std::out_of_range if the number of elements is greater than
+// `capacity()`, which leaves `vector` unchanged, std::invalid_argument if the
+// buffer ends early or its header is not one of this element type and byte
+// order, and the exceptions of the default constructor of value_type. The
+// elements read before an exception of an element are kept.
+template <typename T>
+std::size_t deserialize_from(static_vector_ref<T>& vector, const void* buffer,
+                             std::size_t size) {
+    detail::check_serialization_buffer(detail::serialization_header_size,
+                                       size);
+    const unsigned char* bytes = static_cast<const unsigned char*>(buffer);
+    std::uint32_t element_size;
+    std::uint64_t count;
+    std::memcpy(&element_size, bytes + 4, sizeof(element_size));
+    std::memcpy(&count, bytes + 8, sizeof(count));
+    if (bytes[0] != detail::serialization_tag || bytes[1] != 0 ||
+        bytes[2] != 0 || bytes[3] != 0 ||
+        element_size != detail::serialized_element_size<T>())
+        detail::throw_invalid_serialization(
+            "static_vector serialization: header mismatch");
+    if (vector.capacity() < count)
+        detail::throw_out_of_range(detail::out_of_range_error::count);
+    return detail::serialization_header_size +
+           detail::deserialize_elements(
+               vector, bytes + detail::serialization_header_size,
+               size - detail::serialization_header_size,
+               static_cast<std::size_t>(count),
+               std::is_trivially_copyable<T>{});
+}
+
+#ifdef __cpp_lib_span
+// serialize_into and deserialize_from with the buffer as a std::span
+template <typename T>
+std::size_t serialize_into(const static_vector_ref<T>& vector,
+                           std::span<std::byte> buffer) {
+    return serialize_into(vector, buffer.data(), buffer.size());
+}
+template <typename T>
+std::size_t deserialize_from(static_vector_ref<T>& vector,
+                             std::span<const std::byte> buffer) {
+    return deserialize_from(vector, buffer.data(), buffer.size());
+}
+#endif
+
+} // namespace stlpb
+
+#endif // PALOTASB_STATIC_VECTOR_SERIALIZATION_H
@@ -0,0 +1,305 @@
+#ifndef PALOTASB_STATIC_VECTOR_SIMD_H
+#define PALOTASB_STATIC_VECTOR_SIMD_H
+
+#pragma once
+
+/** Copyrighted according to the LICENSE file.
+ * SPDX-License-Identifier: MIT
+ * */
+
+#include <palotasb/static_vector.hpp>
+
+#include <cstddef>     // std::size_t
+#include <limits>      // std::numeric_limits
+#include <type_traits> // std::is_integral, std::make_unsigned_t
+
+/** Bulk operations on static_vectors of arithmetic types that run over the
+ * whole element storage instead of the elements.
+ *
+ * A loop over `size()` elements vectorizes into a main loop and a scalar
+ * loop for the remaining `size() % lanes` elements, and GCC only vectorizes
+ * such loops from -O3. A static_vector always owns `padded_capacity` slots,
+ * so these kernels loop over all of them, a trip count known at compile
+ * time, and mask the slots past `size()` with a select instead of
+ * branching. The slots past the size hold zeros or stale values of removed
+ * elements, never uninitialized memory, because static_vector
+ * zero-initializes its storage. With a Policy that sets `simd_width`, such as
+ * stlpb::simd_policy, `padded_capacity` is a whole number of registers and
+ * there is no scalar loop at all; the loops vectorize at -O2 too.
+ *
+ * The work is proportional to the capacity, not the size, so the kernels pay
+ * off for vectors that are not mostly empty. Temporaries are at most a
+ * 64 byte block, whatever the capacity, and the capacity must fit in int.
+ *
+ * Hardened builds with AddressSanitizer poison the slots past the size, see
+ * PALOTASB_STATIC_VECTOR_HARDENED; the kernels are not instrumented there.
+ * */
+
+namespace stlpb {
+
+namespace detail {
+
+template <typename T> struct check_simd_element {
+    static_assert(
+        std::is_arithmetic<T>::value && !std::is_same<T, bool>::value,
+        "static_vector SIMD kernels require an arithmetic element type");
+};
+
+// The kernels count the slots with int, which vectorizes with 32-bit lanes
+template <std::size_t Slots> struct check_simd_slots {
+    static_assert(
+        Slots <= static_cast<std::size_t>(std::numeric_limits<int>::max()),
+        "static_vector SIMD kernels require a capacity that fits in int");
+};
+
+// `condition ? a : b` for integers, with a bit mask. Compilers turn the
+// conditional operator into a branch in loops like `sum += i < size ? x : 0`,
+// which then do not vectorize.
+template <typename T> T select(bool condition, T a, T b) noexcept {
+    using bits = std::make_unsigned_t<T>;
+    const bits mask = bits(0) - bits(condition);
+    return T((bits(a) & mask) | (bits(b) & ~mask));
+}
+
+// The number of independent partial results of reductions over the storage
+// of static_vector<T, Capacity, Policy>. Compilers do not reassociate
+// floating-point operations, so those only vectorize when the order is split
+// into lanes: the elements in one register of Policy::simd_width bytes, or of
+// 16 bytes without a simd_width. 1 for integers, which compilers vectorize
+// on their own, and if the storage is not a whole number of registers.
+template <typename T, std::size_t Capacity, typename Policy>
+constexpr int simd_lanes() noexcept {
+    constexpr std::size_t lanes =
+        (Policy::simd_width ? Policy::simd_width : 16) / sizeof(T);
+    return std::is_floating_point<T>::value && lanes >= 2 &&
+                   static_vector<T, Capacity, Policy>::padded_capacity %
+                           lanes ==
+                       0
+               ? static_cast<int>(lanes)
+               : 1;
+}
+
+// Reduce the first `size` of the `Slots` values at `data` with `op`, where
+// `identity` is the neutral element of `op`. Slots past the size are
+// replaced with `identity`, so the loops have a constant trip count and no
+// branches. Integers are masked with select() in a single loop.
+template <int Slots, int Lanes, typename T, typename Op>
+PALOTASB_STATIC_VECTOR_NO_SANITIZE_ADDRESS T masked_reduce(
+    const T* data, std::size_t size, T identity, Op op, std::true_type) {
+    const int count = static_cast<int>(size);
+    T result = identity;
+    for (int i = 0; i < Slots; ++i)
+        result = op(result, select(i < count, data[i], identity));
+    return result;
+}
+// Floating-point values are combined in `Lanes` interleaved partial
+// results, one register at a time: its slots are masked into a temporary
+// first, then combined with the partial results.
+template <int Slots, int Lanes, typename T, typename Op>
+PALOTASB_STATIC_VECTOR_NO_SANITIZE_ADDRESS T masked_reduce(
+    const T* data, std::size_t size, T identity, Op op, std::false_type) {
+    static_assert(Slots % Lanes == 0, "whole lanes");
+    const int count = static_cast<int>(size);
+    T partial[Lanes];
+    for (int j = 0; j < Lanes; ++j)
+        partial[j] = identity;
+    for (int i = 0; i < Slots; i += Lanes) {
+        T masked[Lanes];
+        for (int j = 0; j < Lanes; ++j) {
+            const T x = data[i + j];
+            masked[j] = i + j < count ? x : identity;
+        }
+        for (int j = 0; j < Lanes; ++j)
+            partial[j] = op(partial[j], masked[j]);
+    }
+    T result = identity;
+    for (int j = 0; j < Lanes; ++j)
+        result = op(result, partial[j]);
+    return result;
+}
+
+// Replace the first `size` of the `Slots` values at `data` with `op` of
+// them, evaluating `op` for every slot, with `safe` in place of the values
+// past the size, and selecting the results to keep
+template <int Slots, typename T, typename UnaryOp>
+PALOTASB_STATIC_VECTOR_NO_SANITIZE_ADDRESS void masked_transform(
+    T* data, std::size_t size, UnaryOp op, T safe, std::true_type) {
+    const int count = static_cast<int>(size);
+    for (int i = 0; i < Slots; ++i) {
+        const T x = data[i];
+        const T y = static_cast<T>(op(select(i < count, x, safe)));
+        data[i] = select(i < count, y, x);
+    }
+}
+// masked_transform of one block of `Slots` floating-point values, where the
+// first `count` are elements, in three loops, otherwise compilers move `op`
+// under the condition, which prevents vectorizing operations that may trap
+template <int Slots, typename T, typename UnaryOp>
+PALOTASB_STATIC_VECTOR_NO_SANITIZE_ADDRESS void
+masked_transform_block(T* data, int count, UnaryOp op, T safe) {
+    T results[Slots ? Slots : 1];
+    for (int i = 0; i < Slots; ++i) {
+        const T x = data[i];
+        results[i] = i < count ? x : safe;
+    }
+    for (int i = 0; i < Slots; ++i)
+        results[i] = static_cast<T>(op(results[i]));
+    for (int i = 0; i < Slots; ++i) {
+        const T x = data[i];
+        const T y = results[i];
+        data[i] = i < count ? y : x;
+    }
+}
+// Floating-point values are transformed in blocks of a 64 byte cache line,
+// whole registers of up to 512 bits, so the temporary stays that small
+template <int Slots, typename T, typename UnaryOp>
+PALOTASB_STATIC_VECTOR_NO_SANITIZE_ADDRESS void masked_transform(
+    T* data, std::size_t size, UnaryOp op, T safe, std::false_type) {
+    constexpr int block = static_cast<int>(64 / sizeof(T));
+    const int count = static_cast<int>(size);
+    int i = 0;
+    for (; i + block <= Slots; i += block)
+        masked_transform_block<block>(data + i, count - i, op, safe);
+    masked_transform_block<Slots % block>(data + i, count - i, op, safe);
+}
+
+} // namespace detail
+
+namespace simd {
+
+// Set every element to `value`. All slots of the storage are written.
+// Complexity: O(padded_capacity)
+template <typename T, std::size_t Capacity, typename Policy>
+PALOTASB_STATIC_VECTOR_NO_SANITIZE_ADDRESS void fill(
+    static_vector<T, Capacity, Policy>& v,
+    typename static_vector<T, Capacity, Policy>::value_type value) noexcept {
+    (void)detail::check_simd_element<T>{};
+    (void)detail::check_simd_slots<
+        static_vector<T, Capacity, Policy>::padded_capacity>{};
+    const int slots = static_vector<T, Capacity, Policy>::padded_capacity;
+    T* data = v.data();
+    for (int i = 0; i < slots; ++i)
+        data[i] = value;
+}
+
+// Replace every element `x` with `op(x)`. `op` is evaluated for every slot:
+// for the slots past the size it is called with `safe` instead of their
+// zeros or stale values, which are kept, and its results are discarded.
+// `safe` must be a valid argument of `op`, e.g. not 0 for a division or a
+// negative number for std::sqrt; the default of 1 suits most operations.
+// `op` must not have side effects.
+// Complexity: O(padded_capacity)
+template <
+    typename T, std::size_t Capacity, typename Policy, typename UnaryOp>
+void transform(
+    static_vector<T, Capacity, Policy>& v, UnaryOp op,
+    typename static_vector<T, Capacity, Policy>::value_type safe = 1) {
+    (void)detail::check_simd_element<T>{};
+    (void)detail::check_simd_slots<
+        static_vector<T, Capacity, Policy>::padded_capacity>{};
+    detail::masked_transform<
+        static_vector<T, Capacity, Policy>::padded_capacity>(
+        v.data(), v.size(), op, safe, std::is_integral<T>{});
+}
+
+// The sum of the elements, 0 if empty. Floating-point elements are added in
+// simd_lanes() interleaved partial sums, so the result may differ in
+// rounding from adding them in order.
+// Complexity: O(padded_capacity)
+template <typename T, std::size_t Capacity, typename Policy>
+T sum(const static_vector<T, Capacity, Policy>& v) noexcept {
+    (void)detail::check_simd_element<T>{};
+    (void)detail::check_simd_slots<
+        static_vector<T, Capacity, Policy>::padded_capacity>{};
+    return detail::masked_reduce<
+        static_vector<T, Capacity, Policy>::padded_capacity,
+        detail::simd_lanes<T, Capacity, Policy>()>(
+        v.data(), v.size(), T(0), [](T a, T b) { return T(a + b); },
+        std::is_integral<T>{});
+}
+
+// The smallest element, std::numeric_limits<T>::max() if empty
+// Complexity: O(padded_capacity)
+template <typename T, std::size_t Capacity, typename Policy>
+T min(const static_vector<T, Capacity, Policy>& v) noexcept {
+    (void)detail::check_simd_element<T>{};
+    (void)detail::check_simd_slots<
+        static_vector<T, Capacity, Policy>::padded_capacity>{};
+    return detail::masked_reduce<
+        static_vector<T, Capacity, Policy>::padded_capacity,
+        detail::simd_lanes<T, Capacity, Policy>()>(
+        v.data(), v.size(), std::numeric_limits<T>::max(),
+        [](T a, T b) { return b < a ? b : a; }, std::is_integral<T>{});
+}
+
+// The largest element, std::numeric_limits<T>::lowest() if empty
+// Complexity: O(padded_capacity)
+template <typename T, std::size_t Capacity, typename Policy>
+T max(const static_vector<T, Capacity, Policy>& v) noexcept {
+    (void)detail::check_simd_element<T>{};
+    (void)detail::check_simd_slots<
+        static_vector<T, Capacity, Policy>::padded_capacity>{};
+    return detail::masked_reduce<
+        static_vector<T, Capacity, Policy>::padded_capacity,
+        detail::simd_lanes<T, Capacity, Policy>()>(
+        v.data(), v.size(), std::numeric_limits<T>::lowest(),
+        [](T a, T b) { return a < b ? b : a; }, std::is_integral<T>{});
+}
+
+// The number of elements for which `predicate` holds. `predicate` is
+// evaluated for every slot, it must not have side effects.
+// Complexity: O(padded_capacity)
+template <
+    typename T, std::size_t Capacity, typename Policy, typename Predicate>
+PALOTASB_STATIC_VECTOR_NO_SANITIZE_ADDRESS std::size_t
+count_if(const static_vector<T, Capacity, Policy>& v, Predicate predicate) {
+    (void)detail::check_simd_element<T>{};
+    (void)detail::check_simd_slots<
+        static_vector<T, Capacity, Policy>::padded_capacity>{};
+    const int slots = static_vector<T, Capacity, Policy>::padded_capacity;
+    const int count = static_cast<int>(v.size());
+    const T* data = v.data();
+    int result = 0;
+    for (int i = 0; i < slots; ++i) {
+        const T x = data[i];
+        result += (i < count) & static_cast<bool>(predicate(x));
+    }
+    return static_cast<std::size_t>(result);
+}
+
+// Compare every element to `value`: element i of the result is
+// `comparison(v[i], value)`, e.g. with std::less<T>{} or
+// std::equal_to<T>{}. `comparison` is evaluated for every slot, it must not
+// have side effects.
+// Complexity: O(padded_capacity)
+template <
+    typename T, std::size_t Capacity, typename Policy, typename Compare>
+PALOTASB_STATIC_VECTOR_NO_SANITIZE_ADDRESS static_vector<bool, Capacity, Policy>
+compare(
+    const static_vector<T, Capacity, Policy>& v,
+    typename static_vector<T, Capacity, Policy>::value_type value,
+    Compare comparison) {
+    (void)detail::check_simd_element<T>{};
+    (void)detail::check_simd_slots<
+        static_vector<T, Capacity, Policy>::padded_capacity>{};
+    const int slots = static_vector<T, Capacity, Policy>::padded_capacity;
+    static_assert(
+        static_vector<bool, Capacity, Policy>::padded_capacity >=
+            static_vector<T, Capacity, Policy>::padded_capacity,
+        "the result has a slot for every slot of `v`");
+    static_vector<bool, Capacity, Policy> result;
+    result.resize(v.size(), default_init);
+    const T* data = v.data();
+    bool* out = result.data();
+    for (int i = 0; i < slots; ++i) {
+        const T x = data[i];
+        out[i] = static_cast<bool>(comparison(x, value));
+    }
+    return result;
+}
+
+} // namespace simd
+
+} // namespace stlpb
+
+#endif // PALOTASB_STATIC_VECTOR_SIMD_H
@@ -1,15 +1,44 @@
 #include <palotasb/static_vector.hpp>
+#include <palotasb/static_vector_aggregated.hpp>
+#include <palotasb/static_vector_hashed.hpp>
+#include <palotasb/static_vector_io.hpp>
+#include <palotasb/static_vector_observers.hpp>
+#include <palotasb/static_vector_serialization.hpp>
+#include <palotasb/static_vector_simd.hpp>
 
 #include <algorithm>
+#include <cstdint>
+#include <cstdio>
 #include <exception>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <iterator>
+#include <numeric>
+#include <sstream>
+#include <stdexcept>
 #include <string>
+#include <system_error>
 #include <tuple>
+#include <type_traits>
+#include <unordered_set>
+#include <utility>
+
+#include <fcntl.h>
+#include <unistd.h>
 
 using namespace stlpb;
 
 void assert_failure(const char* expression, const char* file, long line);
 
+// Compare the contents of a container to a list of values
+template <typename Container, typename T>
+bool equals(const Container& c, std::initializer_list<T> expected) {
+    return c.size() == expected.size() &&
+           std::equal(c.begin(), c.end(), expected.begin());
+}
+
 #define ASSERT(e) ((e) ? true : (assert_failure(#e, __FILE__, __LINE__), false))
 
 // Self-referential object that tests whether copies are semantically correct,
@@ -67,6 +96,233 @@ private:
 
 int Movable::constructed_ = 0;
 
+// Counts its objects and throws from the copy constructor once `copies` runs
+// out, to test that throwing inserts leave a valid vector. Moving throws
+// never but is only declared noexcept if NothrowMove.
+template <bool NothrowMove> struct Throwing {
+    Throwing(int v) : value(v) { constructed++; }
+    Throwing(const Throwing& other) : value(other.value) {
+        if (copies-- == 0)
+            throw std::runtime_error("copy");
+        constructed++;
+    }
+    Throwing(Throwing&& other) noexcept(NothrowMove) : value(other.value) {
+        constructed++;
+    }
+    Throwing& operator=(const Throwing&) = default;
+    Throwing& operator=(Throwing&&) noexcept(NothrowMove) = default;
+    ~Throwing() { constructed--; }
+
+    int value;
+    static int constructed;
+    static int copies;
+};
+
+template <bool NothrowMove> int Throwing<NothrowMove>::constructed = 0;
+template <bool NothrowMove> int Throwing<NothrowMove>::copies = -1;
+
+// Move-only handle that opts in to trivial relocation: it has no pointer to
+// itself, so shifting its bytes is a valid move.
+struct Handle {
+    Handle(int v) : p(new int(v)) {}
+    Handle(Handle&& other) noexcept : p(std::move(other.p)) {}
+    Handle& operator=(Handle&& other) noexcept {
+        p = std::move(other.p);
+        return *this;
+    }
+
+    int value() const { return *p; }
+
+private:
+    std::unique_ptr<int> p;
+};
+
+namespace stlpb {
+template <> struct is_trivially_relocatable<Handle> : std::true_type {};
+} // namespace stlpb
+
+static_assert(is_trivially_relocatable<int>::value, "int");
+static_assert(!is_trivially_relocatable<std::string>::value, "std::string");
+static_assert(!is_trivially_relocatable<Copyable>::value, "Copyable");
+
+// The special member functions of static_vector are noexcept exactly when the
+// operations of the element type that they use are.
+template <typename T> struct noexcept_follows_value_type {
+    using V = static_vector<T, 4>;
+    static const bool value =
+        std::is_nothrow_copy_constructible<V>::value ==
+            std::is_nothrow_copy_constructible<T>::value &&
+        std::is_nothrow_copy_assignable<V>::value ==
+            (std::is_nothrow_copy_constructible<T>::value &&
+             std::is_nothrow_copy_assignable<T>::value) &&
+        std::is_nothrow_move_constructible<V>::value ==
+            std::is_nothrow_move_constructible<T>::value &&
+        std::is_nothrow_move_assignable<V>::value ==
+            (std::is_nothrow_move_constructible<T>::value &&
+             std::is_nothrow_move_assignable<T>::value) &&
+        std::is_nothrow_destructible<V>::value ==
+            std::is_nothrow_destructible<T>::value;
+};
+static_assert(noexcept_follows_value_type<int>::value, "int");
+static_assert(noexcept_follows_value_type<std::string>::value, "std::string");
+static_assert(
+    noexcept_follows_value_type<std::unique_ptr<int>>::value,
+    "std::unique_ptr<int>");
+static_assert(noexcept_follows_value_type<Copyable>::value, "Copyable");
+static_assert(noexcept_follows_value_type<Movable>::value, "Movable");
+// std::vector<static_vector<std::string, N>> moves instead of copying when it
+// reallocates.
+static_assert(
+    std::is_nothrow_move_constructible<static_vector<std::string, 16>>::value,
+    "static_vector<std::string, 16> must be nothrow move constructible");
+static_assert(
+    !std::is_nothrow_move_constructible<static_vector<Movable, 16>>::value,
+    "static_vector<Movable, 16> must not be nothrow move constructible");
+static_assert(
+    noexcept(std::declval<static_vector<std::string, 4>&>().swap(
+        std::declval<static_vector<std::string, 4>&>())),
+    "static_vector<std::string, 4>::swap must be noexcept");
+static_assert(
+    !noexcept(std::declval<static_vector<Movable, 4>&>().swap(
+        std::declval<static_vector<Movable, 4>&>())),
+    "static_vector<Movable, 4>::swap must not be noexcept");
+
+// Layout: size and capacity, then the elements, see static_vector
+#if !defined(PALOTASB_STATIC_VECTOR_PROFILE) &&                               \
+    !defined(PALOTASB_STATIC_VECTOR_OBSERVE) &&                               \
+    !defined(PALOTASB_STATIC_VECTOR_ANNOTATE)
+static_assert(
+    sizeof(static_vector<char, 3>) == 3 * sizeof(std::size_t),
+    "static_vector<char, 3> is two size_t followed by 3 chars and padding");
+static_assert(
+    sizeof(static_vector<std::uint64_t, 16>) ==
+        2 * sizeof(std::size_t) + 16 * 8,
+    "static_vector<std::uint64_t, 16> has no padding");
+#endif
+static_assert(
+    alignof(static_vector<int, 16, cache_aligned_policy>) == 64 &&
+        sizeof(static_vector<int, 16, cache_aligned_policy>) % 64 == 0,
+    "cache_aligned_policy aligns to 64 bytes");
+struct aligned_to_128 : static_vector_policy {
+    static constexpr std::size_t alignment = 128;
+};
+static_assert(
+    alignof(static_vector<char, 1, aligned_to_128>) == 128,
+    "policy alignment");
+
+// SIMD padding rounds the storage up to whole registers
+static_assert(
+    static_vector<int, 30, simd_policy>::padded_capacity == 32 &&
+        static_vector<char, 30, simd_policy>::padded_capacity == 32 &&
+        static_vector<double, 30, simd_policy>::padded_capacity == 32 &&
+        static_vector<int, 30>::padded_capacity == 30,
+    "padded_capacity");
+
+#ifdef PALOTASB_STATIC_VECTOR_OBSERVE
+struct counted_policy : static_vector_policy {
+    using observer = counting_observer;
+};
+struct traced_policy : static_vector_policy {
+    using observer = trace_observer;
+};
+#endif
+
+// Takes static_vectors of any capacity
+int sum(const static_vector_ref<int>& v) {
+    int result = 0;
+    for (int x : v)
+        result += x;
+    return result;
+}
+
+// The elements of a static_vector are inside the object
+template <typename T, std::size_t N> bool elements_inside() {
+    static_vector<T, N> v;
+    const char* object = reinterpret_cast<const char*>(&v);
+    const char* data = reinterpret_cast<const char*>(v.data());
+    return object < data && data + N * sizeof(T) <= object + sizeof(v) &&
+           reinterpret_cast<std::uintptr_t>(data) % alignof(T) == 0;
+}
+
+// Whether AddressSanitizer lets access exactly the elements of `v` in builds
+// that annotate the unused slots, see static_vector_ref::annotate_size
+template <typename T> bool annotated(const static_vector_ref<T>& v) {
+#ifdef PALOTASB_STATIC_VECTOR_ANNOTATE
+    const char* first = reinterpret_cast<const char*>(v.data());
+    const char* last = first + v.capacity() * sizeof(T) / 8 * 8;
+    const char* middle = std::min(first + v.size() * sizeof(T), last);
+    return __sanitizer_verify_contiguous_container(first, middle, last) != 0;
+#else
+    (void)v;
+    return true;
+#endif
+}
+
+// An insert whose copy constructor throws leaves the elements unchanged,
+// whether they are inserted in a gap or appended and rotated into place
+template <bool NothrowMove> bool inserts_recover() {
+    using T = Throwing<NothrowMove>;
+    const T values[] = {4, 5, 6};
+    // On the heap: AddressSanitizer unpoisons the stack when throwing
+    std::unique_ptr<static_vector<T, 8>> heap(new static_vector<T, 8>{1, 2, 3});
+    static_vector<T, 8>& v = *heap;
+    const auto unchanged = [&v] {
+        return v.size() == 3 && v[0].value == 1 && v[1].value == 2 &&
+               v[2].value == 3 && T::constructed == 6 && annotated(v);
+    };
+    T::copies = 1;
+    bool thrown = false;
+    try {
+        v.insert(v.begin() + 1, std::begin(values), std::end(values));
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    if (!ASSERT(thrown && unchanged()))
+        return false;
+    T::copies = 2;
+    thrown = false;
+    try {
+        v.insert(v.begin() + 1, 3, values[0]);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    if (!ASSERT(thrown && unchanged()))
+        return false;
+#ifdef PALOTASB_STATIC_VECTOR_RANGES
+    T::copies = 1;
+    thrown = false;
+    try {
+        v.insert_range(v.begin() + 1, values);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    if (!ASSERT(thrown && unchanged()))
+        return false;
+#endif
+    T::copies = 0;
+    thrown = false;
+    try {
+        v.push_back(values[0]);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    if (!ASSERT(thrown && unchanged()))
+        return false;
+    T::copies = 0;
+    thrown = false;
+    try {
+        v.emplace(v.end(), values[0]);
+    } catch (const std::runtime_error&) {
+        thrown = true;
+    }
+    if (!ASSERT(thrown && unchanged()))
+        return false;
+    T::copies = -1;
+    v.insert(v.begin() + 1, std::begin(values), std::end(values));
+    return ASSERT(
+        v.size() == 6 && v[1].value == 4 && v[4].value == 2 && annotated(v));
+}
+
 int main(int, char* []) {
     //
     try {
@@ -211,6 +467,88 @@ int main(int, char* []) {
                 if (!ASSERT(x.verify()))
                     return 1;
         }
+        {
+            // Copy assignment to a longer and a shorter vector
+            static_vector<Copyable, 10> u(3, Copyable{});
+            static_vector<Copyable, 10> v(7, Copyable{});
+            v = u;
+            if (!ASSERT(v.size() == 3))
+                return 1;
+            static_vector<Copyable, 10> w(8, Copyable{});
+            v = w;
+            if (!ASSERT(v.size() == 8))
+                return 1;
+            for (const auto& x : v)
+                if (!ASSERT(x.verify()))
+                    return 1;
+        }
+        {
+            // Move assignment to a longer and a shorter vector
+            static_vector<Movable, 10> u(3);
+            static_vector<Movable, 10> v(7);
+            v = std::move(u);
+            if (!ASSERT(v.size() == 3))
+                return 1;
+            static_vector<Movable, 10> w(8);
+            v = std::move(w);
+            if (!ASSERT(v.size() == 8))
+                return 1;
+            for (const auto& x : v)
+                if (!ASSERT(x.verify()))
+                    return 1;
+        }
+        {
+            // Copy assignment reuses the buffers of assigned strings
+            const std::string long_string(100, 'x');
+            static_vector<std::string, 10> u(4, long_string);
+            static_vector<std::string, 10> v(2, long_string);
+            const char* buffer = v[0].data();
+            v = u;
+            if (!ASSERT(v.size() == 4 && v[0].data() == buffer))
+                return 1;
+        }
+        {
+            // assign
+            static_vector<int, 10> v{1, 2, 3};
+            v.assign(5, 7);
+            if (!ASSERT(equals(v, {7, 7, 7, 7, 7})))
+                return 1;
+            v.assign(2, 8);
+            if (!ASSERT(equals(v, {8, 8})))
+                return 1;
+            int a[] = {4, 5, 6, 7};
+            v.assign(std::begin(a), std::end(a));
+            if (!ASSERT(equals(v, {4, 5, 6, 7})))
+                return 1;
+            v.assign({1, 2});
+            if (!ASSERT(equals(v, {1, 2})))
+                return 1;
+            v = {3, 2, 1};
+            if (!ASSERT(equals(v, {3, 2, 1})))
+                return 1;
+            bool thrown = false;
+            try {
+                v.assign(11, 0);
+            } catch (const std::out_of_range&) {
+                thrown = true;
+            }
+            if (!ASSERT(thrown && equals(v, {3, 2, 1})))
+                return 1;
+        }
+        {
+            // assign with nontrivially copyable type
+            static_vector<Copyable, 10> v(2);
+            v.assign(6, Copyable{});
+            if (!ASSERT(v.size() == 6))
+                return 1;
+            static_vector<Copyable, 10> u(1);
+            v.assign(u.begin(), u.end());
+            if (!ASSERT(v.size() == 1))
+                return 1;
+            for (const auto& x : v)
+                if (!ASSERT(x.verify()))
+                    return 1;
+        }
         {
             // Insert trivial type into empty vector
             static_vector<int, 10> v;
@@ -456,6 +794,908 @@ int main(int, char* []) {
                 if (!(ASSERT(x.verify())))
                     return 1;
         }
+        {
+            // Erase one element of nontrivial type
+            static_vector<Copyable, 10> v(3);
+            v.erase(v.begin() + 1);
+            if (!(ASSERT(v.size() == 2)))
+                return 1;
+            for (const auto& x : v)
+                if (!(ASSERT(x.verify())))
+                    return 1;
+        }
+        {
+            // Insert an element of the vector itself, which is shifted
+            static_vector<int, 10> v{1, 2, 3};
+            v.insert(v.begin(), v[2]);
+            v.insert(v.begin() + 1, 2, v[3]);
+            if (!(ASSERT(equals(v, {3, 3, 3, 1, 2, 3}))))
+                return 1;
+        }
+        {
+            // Insert nontrivial types, fewer than the elements after `pos`
+            static_vector<Copyable, 10> v(5);
+            const Copyable c;
+            auto it = v.insert(v.begin() + 1, 2, c);
+            if (!(ASSERT(v.size() == 7 && it == v.begin() + 1)))
+                return 1;
+            for (const auto& x : v)
+                if (!(ASSERT(x.verify())))
+                    return 1;
+        }
+        {
+            // Insert nontrivial types, more than the elements after `pos`
+            static_vector<Copyable, 10> v(3);
+            const Copyable c;
+            v.insert(v.begin() + 1, 4, c);
+            if (!(ASSERT(v.size() == 7)))
+                return 1;
+            for (const auto& x : v)
+                if (!(ASSERT(x.verify())))
+                    return 1;
+        }
+        {
+            // Erase a range
+            static_vector<int, 10> v{1, 2, 3, 4, 5};
+            auto it = v.erase(v.begin() + 1, v.begin() + 3);
+            if (!(ASSERT(it == v.begin() + 1)))
+                return 1;
+            if (!(ASSERT(equals(v, {1, 4, 5}))))
+                return 1;
+            v.erase(v.begin(), v.end());
+            if (!(ASSERT(v.empty())))
+                return 1;
+        }
+        {
+            // Erase a range of move-only type
+            static_vector<Movable, 10> v(6);
+            v.erase(v.begin() + 1, v.begin() + 3);
+            if (!(ASSERT(v.size() == 4)))
+                return 1;
+            for (const auto& x : v)
+                if (!(ASSERT(x.verify())))
+                    return 1;
+        }
+        {
+            // Unordered erase moves the last element in place
+            static_vector<int, 10> v{1, 2, 3, 4};
+            auto it = v.unordered_erase(v.begin() + 1);
+            if (!(ASSERT(it == v.begin() + 1)))
+                return 1;
+            if (!(ASSERT(equals(v, {1, 4, 3}))))
+                return 1;
+            v.unordered_erase(v.end() - 1);
+            if (!(ASSERT(equals(v, {1, 4}))))
+                return 1;
+        }
+        {
+            // Unordered erase of move-only type
+            static_vector<Movable, 10> v(4);
+            v.unordered_erase(v.begin());
+            v.unordered_erase(v.end() - 1);
+            if (!(ASSERT(v.size() == 2)))
+                return 1;
+            for (const auto& x : v)
+                if (!(ASSERT(x.verify())))
+                    return 1;
+        }
+        {
+            // Insert and erase trivially relocatable type
+            static_vector<Handle, 10> v;
+            for (int i = 0; i < 5; ++i)
+                v.push_back(Handle(i));
+            v.insert(v.begin() + 2, Handle(10));
+            v.emplace(v.begin(), 11);
+            v.erase(v.begin() + 4);
+            v.unordered_erase(v.begin() + 1);
+            v.erase(v.begin(), v.begin() + 1);
+            int expected[] = {4, 1, 10, 3};
+            if (!(ASSERT(v.size() == 4)))
+                return 1;
+            for (std::size_t i = 0; i < v.size(); ++i)
+                if (!(ASSERT(v[i].value() == expected[i])))
+                    return 1;
+        }
+        {
+            // emplace_back and pop_back
+            static_vector<std::pair<int, std::string>, 3> v;
+            auto& first = v.emplace_back(1, "one");
+            if (!ASSERT(&first == &v.back() && first.second == "one"))
+                return 1;
+            v.emplace_back(2, "two");
+            v.pop_back();
+            if (!ASSERT(v.size() == 1 && v.back().first == 1))
+                return 1;
+            v.pop_back();
+            if (!ASSERT(v.empty()))
+                return 1;
+            static_vector<Movable, 3> w;
+            w.emplace_back();
+            w.emplace_back();
+            w.pop_back();
+            if (!ASSERT(w.size() == 1 && w[0].verify()))
+                return 1;
+        }
+        {
+            // resize
+            static_vector<int, 10> v{1, 2, 3};
+            v.resize(5);
+            if (!ASSERT(equals(v, {1, 2, 3, 0, 0})))
+                return 1;
+            v.resize(2);
+            if (!ASSERT(equals(v, {1, 2})))
+                return 1;
+            v.resize(4, 7);
+            if (!ASSERT(equals(v, {1, 2, 7, 7})))
+                return 1;
+            v.resize(6, default_init);
+            if (!ASSERT(v.size() == 6 && v[3] == 7))
+                return 1;
+            bool thrown = false;
+            try {
+                v.resize(11);
+            } catch (const std::out_of_range&) {
+                thrown = true;
+            }
+            if (!ASSERT(thrown && v.size() == 6))
+                return 1;
+            static_vector<Copyable, 10> w(2);
+            w.resize(8, Copyable{});
+            w.resize(5);
+            w.resize(7, default_init);
+            if (!ASSERT(w.size() == 7))
+                return 1;
+            for (const auto& x : w)
+                if (!ASSERT(x.verify()))
+                    return 1;
+        }
+        {
+            // checkpoint and rollback
+            static_vector<int, 10> v{1, 2};
+            const auto mark = v.checkpoint();
+            v.push_back(3);
+            v.push_back(4);
+            v.rollback(mark);
+            if (!ASSERT(equals(v, {1, 2})))
+                return 1;
+            v.rollback(v.checkpoint());
+            if (!ASSERT(equals(v, {1, 2})))
+                return 1;
+            {
+                auto guard = v.scoped_checkpoint();
+                v.push_back(3);
+                {
+                    auto inner = v.scoped_checkpoint();
+                    v.push_back(4);
+                    inner.commit();
+                }
+                if (!ASSERT(equals(v, {1, 2, 3, 4})))
+                    return 1;
+            }
+            if (!ASSERT(equals(v, {1, 2})))
+                return 1;
+            {
+                auto guard = v.scoped_checkpoint();
+                v.push_back(3);
+                auto moved = std::move(guard);
+                guard.rollback();
+                if (!ASSERT(v.size() == 3 && moved.mark().size == 2))
+                    return 1;
+                moved.commit();
+            }
+            if (!ASSERT(equals(v, {1, 2, 3})))
+                return 1;
+            static_vector<Copyable, 10> w(2);
+            const int before = Copyable::constructed();
+            {
+                static_vector_ref<Copyable>& ref = w;
+                auto guard = ref.scoped_checkpoint();
+                w.resize(6);
+            }
+            if (!ASSERT(w.size() == 2 && Copyable::constructed() == before))
+                return 1;
+            for (const auto& x : w)
+                if (!ASSERT(x.verify()))
+                    return 1;
+        }
+        {
+            // concat, take, drop, split_at and static_vector_cast compute
+            // their capacities at compile time
+            static_vector<int, 4> a{1, 2, 3};
+            static_vector<int, 2> b{4};
+            auto ab = concat(a, b);
+            static_assert(
+                std::is_same<decltype(ab), static_vector<int, 6>>::value,
+                "concat adds the capacities");
+            if (!ASSERT(equals(ab, {1, 2, 3, 4})))
+                return 1;
+            auto front = take<2>(ab);
+            static_assert(
+                std::is_same<decltype(front), static_vector<int, 2>>::value,
+                "take<K> has capacity K");
+            auto back = drop<2>(ab);
+            static_assert(
+                std::is_same<decltype(back), static_vector<int, 4>>::value,
+                "drop<K> has capacity N - K");
+            if (!ASSERT(equals(front, {1, 2}) && equals(back, {3, 4})))
+                return 1;
+            if (!ASSERT(take<2>(b).size() == 1 && drop<1>(b).empty()))
+                return 1;
+            auto halves = split_at<3>(ab);
+            if (!ASSERT(
+                    equals(halves.first, {1, 2, 3}) &&
+                    equals(halves.second, {4})))
+                return 1;
+            auto wide = static_vector_cast<8>(a);
+            static_assert(
+                std::is_same<decltype(wide), static_vector<int, 8>>::value,
+                "static_vector_cast<M> has capacity M");
+            if (!ASSERT(equals(wide, {1, 2, 3})))
+                return 1;
+            static_vector<Movable, 3> m(2);
+            static_vector<Movable, 3> n(3);
+            auto mn = concat(std::move(m), std::move(n));
+            auto parts = split_at<2>(std::move(mn));
+            auto rest = static_vector_cast<6>(std::move(parts.second));
+            if (!ASSERT(parts.first.size() == 2 && rest.size() == 3))
+                return 1;
+            for (const auto& x : rest)
+                if (!ASSERT(x.verify()))
+                    return 1;
+            static_vector<std::string, 2> s{"one", "two"};
+            auto copied = concat(s, s);
+            if (!ASSERT(copied.size() == 4 && s[1] == "two"))
+                return 1;
+        }
+        {
+            // hashed_static_vector keeps the hash of its elements up to date
+            using hashed = hashed_static_vector<std::string, 8>;
+            hashed v;
+            auto rehashed = [](const hashed& h) {
+                return hashed(h.vector()).hash() == h.hash();
+            };
+            v.push_back("b");
+            v.emplace_back("d");
+            v.insert(v.begin(), "a");
+            v.insert(v.begin() + 2, "c");
+            if (!ASSERT(rehashed(v)))
+                return 1;
+            hashed w{"a", "b", "c", "d"};
+            if (!ASSERT(v == w && v.hash() == std::hash<hashed>{}(w)))
+                return 1;
+            v.erase(v.begin() + 1);
+            v.push_back("e");
+            v.erase(v.begin(), v.begin() + 2);
+            if (!ASSERT(rehashed(v) && equals(v.vector(), {"d", "e"})))
+                return 1;
+            v.pop_back();
+            if (!ASSERT(rehashed(v) && v != w && v == hashed{"d"}))
+                return 1;
+            v.swap(w);
+            if (!ASSERT(rehashed(v) && rehashed(w) && w.size() == 1))
+                return 1;
+            v.clear();
+            if (!ASSERT(v == hashed{} && hashed{""} != hashed{}))
+                return 1;
+        }
+        {
+            // aggregated_static_vector keeps running aggregates
+            using stats =
+                aggregates<sum_aggregate<int>, min_aggregate<int>,
+                           max_aggregate<int>>;
+            aggregated_static_vector<int, 8, stats> v;
+            auto aggregate_is = [&v](int sum, int min, int max) {
+                return v.aggregate() == std::make_tuple(sum, min, max);
+            };
+            if (!ASSERT(aggregate_is(
+                    0, std::numeric_limits<int>::max(),
+                    std::numeric_limits<int>::lowest())))
+                return 1;
+            v.push_back(3);
+            v.push_back(7);
+            v.emplace_back(-2);
+            if (!ASSERT(aggregate_is(8, -2, 7)))
+                return 1;
+            v.pop_back();
+            if (!ASSERT(aggregate_is(10, 3, 7)))
+                return 1;
+            v.insert(v.begin(), 9);
+            v.push_back(1);
+            if (!ASSERT(aggregate_is(20, 1, 9)))
+                return 1;
+            v.erase(v.begin() + 1, v.begin() + 3);
+            if (!ASSERT(equals(v, {9, 1}) && aggregate_is(10, 1, 9)))
+                return 1;
+            v.clear();
+            v.push_back(4);
+            if (!ASSERT(aggregate_is(4, 4, 4)))
+                return 1;
+            aggregated_static_vector<double, 4, max_aggregate<double>> w{
+                1.5, 0.5};
+            if (!ASSERT(w.aggregate() == 1.5))
+                return 1;
+        }
+#ifdef PALOTASB_STATIC_VECTOR_OBSERVE
+        {
+            // Observers see construction, size changes, shifts and overflows
+            const observer_counts before = counting_observer::counts();
+            static_vector<int, 4, counted_policy> v{1, 2};
+            v.insert(v.begin(), 0);
+            v.push_back(3);
+            v.erase(v.begin(), v.begin() + 2);
+            v.pop_back();
+            try {
+                v.insert(v.end(), 5, 0);
+            } catch (const std::out_of_range&) {
+            }
+            static_vector<int, 4> unobserved{1, 2, 3};
+            unobserved.erase(unobserved.begin());
+            const observer_counts& after = counting_observer::counts();
+            if (!ASSERT(
+                    after.constructs - before.constructs == 1 &&
+                    after.grows - before.grows == 3 &&
+                    after.shrinks - before.shrinks == 2 &&
+                    after.overflows - before.overflows == 1 &&
+                    after.shifts - before.shifts == 2 &&
+                    after.shifted_elements - before.shifted_elements == 4 &&
+                    after.fill[10] - before.fill[10] == 1))
+                return 1;
+            static_vector<int, 2, traced_policy> traced;
+            traced.push_back(1);
+            traced.pop_back();
+        }
+#endif
+#ifdef PALOTASB_STATIC_VECTOR_RANGES
+        {
+            // Construction from ranges and the *_range functions, with sized
+            // ranges and with ranges that are only read once
+            auto squares = std::views::iota(1, 5) |
+                           std::views::transform([](int x) { return x * x; });
+            auto odd = std::views::iota(1, 10) |
+                       std::views::filter([](int x) { return x % 2 != 0; });
+            static_vector<int, 8> v(from_range, squares);
+            if (!ASSERT(equals(v, {1, 4, 9, 16})))
+                return 1;
+            v.append_range(std::views::iota(20, 22));
+            v.insert_range(v.begin() + 1, odd | std::views::take(2));
+            if (!ASSERT(equals(v, {1, 1, 3, 4, 9, 16, 20, 21})))
+                return 1;
+            bool thrown = false;
+            try {
+                v.append_range(odd);
+            } catch (const std::out_of_range&) {
+                thrown = true;
+            }
+            if (!ASSERT(thrown && equals(v, {1, 1, 3, 4, 9, 16, 20, 21})))
+                return 1;
+            thrown = false;
+            try {
+                v.insert_range(v.begin(), squares);
+            } catch (const std::out_of_range&) {
+                thrown = true;
+            }
+            if (!ASSERT(thrown && equals(v, {1, 1, 3, 4, 9, 16, 20, 21})))
+                return 1;
+            v.assign_range(odd);
+            if (!ASSERT(equals(v, {1, 3, 5, 7, 9})))
+                return 1;
+            v.assign_range(squares);
+            if (!ASSERT(equals(v, {1, 4, 9, 16})))
+                return 1;
+            static_vector<Copyable, 4> w(
+                from_range, static_vector<Copyable, 2>(2));
+            const int before = Copyable::constructed();
+            thrown = false;
+            try {
+                w.append_range(
+                    std::views::iota(0, 3) |
+                    std::views::filter([](int) { return true; }) |
+                    std::views::transform([](int) { return Copyable(); }));
+            } catch (const std::out_of_range&) {
+                thrown = true;
+            }
+            if (!ASSERT(thrown && w.size() == 2 &&
+                        Copyable::constructed() == before))
+                return 1;
+#if defined(__cpp_lib_ranges_to_container)
+            if (!ASSERT(equals(
+                    std::ranges::to<static_vector<int, 8>>(odd),
+                    {1, 3, 5, 7, 9})))
+                return 1;
+#endif
+        }
+#endif
+        {
+            // Single-pass input iterators are read once, checking the
+            // capacity per element
+            using numbers = std::istream_iterator<int>;
+            std::istringstream in("1 2 3");
+            static_vector<int, 8> v{numbers(in), numbers()};
+            if (!ASSERT(equals(v, {1, 2, 3})))
+                return 1;
+            in = std::istringstream("4 5");
+            v.insert(v.begin() + 1, numbers(in), numbers());
+            if (!ASSERT(equals(v, {1, 4, 5, 2, 3})))
+                return 1;
+            in = std::istringstream("6 7 8 9 10");
+            bool thrown = false;
+            try {
+                v.insert(v.begin(), numbers(in), numbers());
+            } catch (const std::out_of_range&) {
+                thrown = true;
+            }
+            if (!ASSERT(thrown && equals(v, {1, 4, 5, 2, 3})))
+                return 1;
+            in = std::istringstream("6 7");
+            v.assign(numbers(in), numbers());
+            if (!ASSERT(equals(v, {6, 7})))
+                return 1;
+            in = std::istringstream("1 2 3 4 5 6 7 8");
+            v.assign(numbers(in), numbers());
+            if (!ASSERT(v.full() && v.back() == 8))
+                return 1;
+            in = std::istringstream("1 2 3");
+            thrown = false;
+            try {
+                static_vector<int, 2> w{numbers(in), numbers()};
+            } catch (const std::out_of_range&) {
+                thrown = true;
+            }
+            if (!ASSERT(thrown))
+                return 1;
+        }
+        {
+            // Reading bytes into the unused slots
+            static_vector<int, 8> v{1, 2};
+            v.resize_and_overwrite(5, [](int* data, std::size_t count) {
+                std::fill(data + 2, data + count, 9);
+                return count - 1;
+            });
+            if (!ASSERT(equals(v, {1, 2, 9, 9})))
+                return 1;
+            int fds[2];
+            if (!ASSERT(::pipe(fds) == 0))
+                return 1;
+            if (!ASSERT(::write(fds[1], "hello world", 11) == 11))
+                return 1;
+            static_vector<char, 8> bytes{'>'};
+            if (!ASSERT(append_some_from_fd(bytes, fds[0], 5) == 5 &&
+                        std::string(bytes.begin(), bytes.end()) == ">hello"))
+                return 1;
+            ::close(fds[1]);
+            if (!ASSERT(append_from_fd(bytes, fds[0]) == 2 && bytes.full() &&
+                        append_from_fd(bytes, fds[0]) == 0))
+                return 1;
+            bytes.clear();
+            if (!ASSERT(append_from_fd(bytes, fds[0]) == 4 &&
+                        std::string(bytes.begin(), bytes.end()) == "orld"))
+                return 1;
+            ::close(fds[0]);
+            std::FILE* file = std::tmpfile();
+            if (!ASSERT(file && std::fputs("0123456789", file) >= 0 &&
+                        std::fflush(file) == 0))
+                return 1;
+            bytes.clear();
+            if (!ASSERT(append_from_fd_at(bytes, ::fileno(file), 3, 4) == 4 &&
+                        std::string(bytes.begin(), bytes.end()) == "3456"))
+                return 1;
+            std::rewind(file);
+            if (!ASSERT(append_from(bytes, file) == 4 &&
+                        std::string(bytes.begin(), bytes.end()) == "34560123"))
+                return 1;
+            std::fclose(file);
+            bytes.clear();
+            bool thrown = false;
+            try {
+                append_from_fd(bytes, -1);
+            } catch (const std::system_error& e) {
+                thrown = e.code() == std::errc::bad_file_descriptor;
+            }
+            if (!ASSERT(thrown && bytes.empty()))
+                return 1;
+        }
+        {
+            // Scatter/gather I/O
+            static_iovec_builder<4, 8> message;
+            const std::string body = "payload";
+            message.append_copy("[", 1);
+            message.append(body);
+            message.append_copy("]", 1);
+            message.append_copy("!", 1);
+            if (!ASSERT(message.entries().size() == 3 &&
+                        message.bytes() == 10))
+                return 1;
+            bool thrown = false;
+            try {
+                message.append_copy("too long!", 9);
+            } catch (const std::out_of_range&) {
+                thrown = true;
+            }
+            if (!ASSERT(thrown && message.entries().size() == 3 &&
+                        message.bytes() == 10))
+                return 1;
+            // The bytes copied for an entry that does not fit are dropped
+            message.append(body);
+            thrown = false;
+            try {
+                message.append_copy("?", 1);
+            } catch (const std::out_of_range&) {
+                thrown = true;
+            }
+            if (!ASSERT(thrown && message.entries().size() == 4 &&
+                        message.bytes() == 17))
+                return 1;
+            message.entries().pop_back();
+            int fds[2];
+            if (!ASSERT(::pipe(fds) == 0))
+                return 1;
+            if (!ASSERT(message.write_to(fds[1]) == 10 &&
+                        message.entries().empty()))
+                return 1;
+            char head[4];
+            char tail[6];
+            static_vector<iovec, 2> buffers{iovec{head, 4}, iovec{tail, 6}};
+            if (!ASSERT(readv_all(fds[0], buffers) == 10 && buffers.empty() &&
+                        std::string(head, 4) + std::string(tail, 6) ==
+                            "[payload]!"))
+                return 1;
+            // A partial write leaves the rest to write
+            ::fcntl(fds[1], F_SETFL, O_NONBLOCK);
+            std::string large(1 << 20, 'x');
+            const std::size_t half = large.size() / 2;
+            static_vector<iovec, 2> pieces{iovec{&large[0], half},
+                                           iovec{&large[half], half}};
+            thrown = false;
+            try {
+                writev_all(fds[1], pieces);
+            } catch (const std::system_error& e) {
+                thrown = e.code() == std::errc::resource_unavailable_try_again;
+            }
+            if (!ASSERT(thrown))
+                return 1;
+            if (!ASSERT(pieces.size() == 2 &&
+                        pieces[0].iov_base > &large[0] &&
+                        pieces[1].iov_len == half))
+                return 1;
+            ::close(fds[0]);
+            ::close(fds[1]);
+        }
+        {
+            // Binary serialization: one memcpy for trivially copyable types
+            struct record {
+                int id = -1;
+                double value;
+            };
+            static_vector<record, 4> records;
+            records.push_back({1, 0.5});
+            records.push_back({2, 1.5});
+            unsigned char buffer[128];
+            const std::size_t written =
+                serialize_into(records, buffer, sizeof(buffer));
+            if (!ASSERT(written == serialized_size(records) &&
+                        written == 16 + 2 * sizeof(record)))
+                return 1;
+            static_vector<record, 4> copy{record{}};
+            if (!ASSERT(deserialize_from(copy, buffer, written) == written &&
+                        copy.size() == 2 && copy[1].id == 2 &&
+                        copy[1].value == 1.5))
+                return 1;
+            static_vector<int, 4> ints{1, 2, 3, 4};
+            static_vector<int, 2> small{7};
+            serialize_into(ints, buffer, sizeof(buffer));
+            bool thrown = false;
+            try {
+                deserialize_from(small, buffer, sizeof(buffer));
+            } catch (const std::out_of_range&) {
+                thrown = true;
+            }
+            if (!ASSERT(thrown && equals(small, {7})))
+                return 1;
+            thrown = false;
+            try {
+                deserialize_from(ints, buffer, 16 + 3 * sizeof(int));
+            } catch (const std::invalid_argument&) {
+                thrown = true;
+            }
+            if (!ASSERT(thrown))
+                return 1;
+            thrown = false;
+            try {
+                deserialize_from(copy, buffer, sizeof(buffer));
+            } catch (const std::invalid_argument&) {
+                thrown = true;
+            }
+            if (!ASSERT(thrown && copy.size() == 2 && copy[1].id == 2))
+                return 1;
+            thrown = false;
+            try {
+                serialize_into(ints, buffer, 16);
+            } catch (const std::invalid_argument&) {
+                thrown = true;
+            }
+            if (!ASSERT(thrown))
+                return 1;
+            // Element by element for other types
+            static_vector<static_vector<int, 4>, 3> nested{{1, 2}, {}, {3}};
+            static_vector<static_vector<int, 4>, 3> nested_copy;
+            const std::size_t nested_size =
+                serialize_into(nested, buffer, sizeof(buffer));
+            if (!ASSERT(nested_size == serialized_size(nested) &&
+                        deserialize_from(nested_copy, buffer, nested_size) ==
+                            nested_size &&
+                        nested_copy == nested))
+                return 1;
+#ifdef __cpp_lib_span
+            const auto bytes = std::as_writable_bytes(std::span(buffer));
+            if (!ASSERT(serialize_into(ints, bytes) == 32 &&
+                        deserialize_from(ints, std::span<const std::byte>(
+                                                   bytes)) == 32 &&
+                        equals(ints, {1, 2, 3, 4})))
+                return 1;
+#endif
+        }
+        {
+            // Inserts with a throwing copy constructor in the middle
+            if (!inserts_recover<true>() || !inserts_recover<false>())
+                return 1;
+        }
+        {
+            // swap with ints and with a trivially relocatable type
+            static_vector<int, 10> u{1, 2, 3, 4, 5};
+            static_vector<int, 10> v{6, 7};
+            u.swap(v);
+            if (!ASSERT(equals(u, {6, 7}) && equals(v, {1, 2, 3, 4, 5})))
+                return 1;
+            swap(u, v);
+            if (!ASSERT(equals(u, {1, 2, 3, 4, 5}) && equals(v, {6, 7})))
+                return 1;
+            static_vector<Handle, 10> a;
+            static_vector<Handle, 10> b;
+            a.emplace_back(1);
+            b.emplace_back(2);
+            b.emplace_back(3);
+            a.swap(b);
+            if (!ASSERT(a.size() == 2 && a[0].value() == 2))
+                return 1;
+            if (!ASSERT(a[1].value() == 3))
+                return 1;
+            if (!ASSERT(b.size() == 1 && b[0].value() == 1))
+                return 1;
+            // Byte counts that are not multiples of the word size
+            static_vector<char, 300> x(299, 'x');
+            static_vector<char, 300> y(13, 'y');
+            x.swap(y);
+            if (!ASSERT(x.size() == 13 && y.size() == 299 &&
+                        std::count(x.begin(), x.end(), 'y') == 13 &&
+                        std::count(y.begin(), y.end(), 'x') == 299))
+                return 1;
+        }
+        {
+            // swap with nontrivially movable type
+            static_vector<Movable, 10> u(6);
+            static_vector<Movable, 10> v(2);
+            u.swap(v);
+            if (!ASSERT(u.size() == 2 && v.size() == 6))
+                return 1;
+            v.swap(u);
+            if (!ASSERT(u.size() == 6 && v.size() == 2))
+                return 1;
+            for (const auto& x : u)
+                if (!ASSERT(x.verify()))
+                    return 1;
+            for (const auto& x : v)
+                if (!ASSERT(x.verify()))
+                    return 1;
+        }
+        {
+            // Comparison operators with ints
+            static_vector<int, 10> a{1, 2, 3};
+            static_vector<int, 10> b{1, 2, 3};
+            static_vector<int, 10> c{1, 2, 4};
+            static_vector<int, 10> d{1, 2};
+            static_vector<int, 10> e;
+            if (!ASSERT(a == b && !(a != b) && a != c && a != d && e == e))
+                return 1;
+            if (!ASSERT(a < c && c > a && d < a && e < d && !(a < b)))
+                return 1;
+            if (!ASSERT(a <= b && a >= b && a <= c && !(a >= c)))
+                return 1;
+            static_vector<int, 10> negative{-1};
+            if (!ASSERT(!(negative < e) && negative < d))
+                return 1;
+        }
+        {
+            // Comparison operators with bytes, ordered by memcmp, and strings
+            static_vector<unsigned char, 4> a{1, 255};
+            static_vector<unsigned char, 4> b{1, 2, 3};
+            static_vector<unsigned char, 4> c{1, 255, 0};
+            if (!ASSERT(b < a && a < c && !(c < a) && a == a))
+                return 1;
+            static_vector<std::string, 4> u{"a", "bc"};
+            static_vector<std::string, 4> v{"a", "bd"};
+            if (!ASSERT(u != v && u < v && u == u))
+                return 1;
+        }
+        {
+            // std::hash
+            using key = static_vector<int, 4>;
+            std::hash<key> hash;
+            if (!ASSERT(hash(key{1, 2, 3}) == hash(key{1, 2, 3})))
+                return 1;
+            if (!ASSERT(hash(key{1, 2, 3}) != hash(key{1, 2, 4})))
+                return 1;
+            if (!ASSERT(hash(key{0}) != hash(key{0, 0})))
+                return 1;
+            std::unordered_set<key> set{{1, 2}, {2, 1}, {1, 2}, {}};
+            if (!ASSERT(set.size() == 3 && set.count(key{2, 1}) == 1))
+                return 1;
+            using strings = static_vector<std::string, 4>;
+            std::unordered_set<strings> string_set{{"a", "b"}, {"a", "b"}};
+            if (!ASSERT(string_set.size() == 1))
+                return 1;
+        }
+        {
+            // static_vector_ref works with static_vectors of any capacity
+            static_vector<int, 4> small{1, 2, 3};
+            static_vector<int, 16> large{4, 5};
+            if (!ASSERT(sum(small) == 6 && sum(large) == 9))
+                return 1;
+            static_vector_ref<int>& ref = large;
+            ref.push_back(6);
+            if (!ASSERT(ref.capacity() == 16 && equals(large, {4, 5, 6})))
+                return 1;
+            ref = small;
+            if (!ASSERT(equals(large, {1, 2, 3}) && large == small))
+                return 1;
+            large.push_back(4);
+            if (!ASSERT(small < large && large != small))
+                return 1;
+            small = std::move(ref);
+            if (!ASSERT(equals(small, {1, 2, 3, 4})))
+                return 1;
+            large.push_back(5);
+            bool thrown = false;
+            try {
+                small = large;
+            } catch (const std::out_of_range&) {
+                thrown = true;
+            }
+            if (!ASSERT(thrown && equals(small, {1, 2, 3, 4})))
+                return 1;
+        }
+        {
+            // Element storage offset
+            struct alignas(32) aligned {
+                char c;
+            };
+            if (!ASSERT((elements_inside<char, 3>())))
+                return 1;
+            if (!ASSERT((elements_inside<double, 5>())))
+                return 1;
+            if (!ASSERT((elements_inside<aligned, 2>())))
+                return 1;
+            // Element access and copies with an aligned policy
+            static_vector<int, 5, cache_aligned_policy> v{1, 2, 3};
+            static_vector<int, 5, cache_aligned_policy> w = v;
+            if (!ASSERT(
+                    reinterpret_cast<std::uintptr_t>(&w) % 64 == 0 &&
+                    w == v && sum(w) == 6))
+                return 1;
+        }
+        {
+            // Straight-line insert, erase, find and == of small capacities
+            // agree with the generic versions of static_vector_ref
+#ifndef PALOTASB_STATIC_VECTOR_ANNOTATE
+            static_assert(
+                detail::is_unrolled<int, 4>::value &&
+                    !detail::is_unrolled<int, 16>::value &&
+                    !detail::is_unrolled<std::string, 4>::value &&
+                    detail::is_unrolled_comparable<int, 4>::value &&
+                    !detail::is_unrolled_comparable<int, 8>::value,
+                "small capacities of trivially copyable types are unrolled");
+#endif
+            using small = static_vector<int, 4>;
+            for (int size = 0; size < 4; ++size)
+                for (int i = 0; i <= size; ++i) {
+                    small v;
+                    for (int j = 0; j < size; ++j)
+                        v.push_back(j + 1);
+                    small w = v;
+                    static_vector_ref<int>& generic = w;
+                    v.insert(v.begin() + i, 9);
+                    generic.insert(generic.begin() + i, 9);
+                    if (!ASSERT(v == w && v.find(9) == v.begin() + i))
+                        return 1;
+                    v.erase(v.begin() + i);
+                    generic.erase(generic.begin() + i);
+                    if (!ASSERT(v == w && !v.contains(9)))
+                        return 1;
+                    if (!ASSERT(v.find(0) == v.end() && !v.contains(5)))
+                        return 1;
+                }
+            // Stale elements past the size are ignored
+            small a{1, 2, 3};
+            small b{1, 2, 4};
+            a.pop_back();
+            b.pop_back();
+            if (!ASSERT(a == b && !a.contains(3) && a.find(2) == a.begin() + 1))
+                return 1;
+            a.insert(a.begin(), a.back());
+            small copy(a);
+            if (!ASSERT(
+                    equals(copy, {2, 1, 2}) && copy.find(2) == copy.begin()))
+                return 1;
+            copy.push_back(3);
+            bool thrown = false;
+            try {
+                copy.insert(copy.begin(), 0);
+            } catch (const std::out_of_range&) {
+                thrown = true;
+            }
+            if (!ASSERT(thrown && equals(copy, {2, 1, 2, 3})))
+                return 1;
+            static_vector<std::string, 4> strings{"a", "b"};
+            strings.insert(strings.begin(), "c");
+            strings.erase(strings.begin() + 1);
+            if (!ASSERT(strings.contains("b") && !strings.contains("a")))
+                return 1;
+        }
+        {
+            // SIMD kernels with and without padding, ignoring stale values
+            static_vector<int, 30, simd_policy> v{5, -3, 8, 1, 9};
+            v.push_back(100);
+            v.pop_back();
+            static_vector<int, 7> w(v.begin(), v.end());
+            if (!ASSERT(simd::sum(v) == 20 && simd::sum(w) == 20))
+                return 1;
+            if (!ASSERT(simd::min(v) == -3 && simd::max(w) == 9))
+                return 1;
+            auto positive = [](int x) { return x > 0; };
+            if (!ASSERT(
+                    simd::count_if(v, positive) == 4 &&
+                    simd::count_if(w, positive) == 4))
+                return 1;
+            auto less = simd::compare(v, 5, std::less<int>{});
+            if (!ASSERT(equals(less, {false, true, false, true, false})))
+                return 1;
+            simd::transform(v, [](int x) { return 2 * x; });
+            if (!ASSERT(equals(v, {10, -6, 16, 2, 18})))
+                return 1;
+            // Operations are not called with the zeros past the size
+            static_vector<int, 30, simd_policy> divisors{2, -4, 8};
+            simd::transform(divisors, [](int x) { return 64 / x; });
+            if (!ASSERT(equals(divisors, {32, -16, 8})))
+                return 1;
+            simd::transform(divisors, [](int x) { return 64 / (x - 1); }, 2);
+            if (!ASSERT(equals(divisors, {2, -3, 9})))
+                return 1;
+            v.push_back(0);
+            if (!ASSERT(v.back() == 0 && simd::sum(v) == 40))
+                return 1;
+            simd::fill(w, 7);
+            if (!ASSERT(equals(w, {7, 7, 7, 7, 7})))
+                return 1;
+            static_vector<int, 30, simd_policy> empty;
+            if (!ASSERT(
+                    simd::sum(empty) == 0 &&
+                    simd::min(empty) == std::numeric_limits<int>::max()))
+                return 1;
+            static_vector<float, 30, simd_policy> floats;
+            for (int i = 0; i < 29; ++i)
+                floats.push_back(static_cast<float>(i));
+            if (!ASSERT(
+                    simd::sum(floats) ==
+                        std::accumulate(floats.begin(), floats.end(), 0.0f) &&
+                    simd::max(floats) == 28.0f))
+                return 1;
+            // Large capacities are processed in blocks, the last one partial
+            static_vector<double, 10003> large(10001, 1.0);
+            simd::transform(large, [](double x) { return x / 2; });
+            if (!ASSERT(
+                    simd::sum(large) == 5000.5 && large.back() == 0.5 &&
+                    simd::max(large) == 0.5))
+                return 1;
+        }
         {
             // Test STL algorithm support: std::rotate
             // Example code taken from:
@@ -0,0 +1,310 @@
+#include <palotasb/static_vector.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <new>
+#include <stdexcept>
+
+// Verifies that static_vector never allocates heap memory.
+//
+// Global `operator new` is replaced with a counting version, and on glibc so
+// are `malloc`, `calloc` and `realloc`. Every constructor, modifier and some
+// algorithms are run between resetting and reading the counters. The
+// operations that throw are checked separately: the C++ runtime allocates the
+// exception object itself with `malloc`, but static_vector must not allocate
+// anything else, such as the exception message.
+
+using namespace stlpb;
+
+namespace {
+
+// Counters are only incremented while `counting` is set, so that the test
+// harness itself (reporting, exception handling setup) is not measured.
+bool counting = false;
+long operator_new_count = 0;
+long malloc_count = 0;
+
+} // namespace
+
+#if defined(__GLIBC__)
+extern "C" {
+void* __libc_malloc(std::size_t size);
+void* __libc_calloc(std::size_t count, std::size_t size);
+void* __libc_realloc(void* ptr, std::size_t size);
+
+void* malloc(std::size_t size) {
+    if (counting)
+        ++malloc_count;
+    return __libc_malloc(size);
+}
+void* calloc(std::size_t count, std::size_t size) {
+    if (counting)
+        ++malloc_count;
+    return __libc_calloc(count, size);
+}
+void* realloc(void* ptr, std::size_t size) {
+    if (counting)
+        ++malloc_count;
+    return __libc_realloc(ptr, size);
+}
+}
+#define RAW_MALLOC __libc_malloc
+#else
+#define RAW_MALLOC std::malloc
+#endif
+
+void* operator new(std::size_t size) {
+    if (counting)
+        ++operator_new_count;
+    if (void* ptr = RAW_MALLOC(size ? size : 1))
+        return ptr;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    if (counting)
+        ++operator_new_count;
+    return RAW_MALLOC(size ? size : 1);
+}
+void* operator new[](std::size_t size, const std::nothrow_t& tag) noexcept {
+    return operator new(size, tag);
+}
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete[](void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { std::free(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { std::free(ptr); }
+
+namespace {
+
+int failures = 0;
+
+// Run `f` and check that it neither calls operator new nor malloc.
+template <typename F> void check_no_alloc(const char* name, F f) {
+    operator_new_count = malloc_count = 0;
+    counting = true;
+    f();
+    counting = false;
+    bool ok = operator_new_count == 0 && malloc_count == 0;
+    if (!ok)
+        ++failures;
+    std::printf(
+        "%-4s %-40s operator new: %ld, malloc: %ld\n", ok ? "ok" : "FAIL",
+        name, operator_new_count, malloc_count);
+}
+
+// Run `f`, which must throw std::out_of_range, and check that nothing but the
+// exception object is allocated. The exception is thrown once before
+// counting so that one-time initialization is not measured.
+template <typename F> void check_throw_no_alloc(const char* name, F f) {
+    auto run = [&] {
+        try {
+            f();
+        } catch (const std::out_of_range&) {
+            return true;
+        }
+        return false;
+    };
+    run();
+    operator_new_count = malloc_count = 0;
+    counting = true;
+    bool thrown = run();
+    counting = false;
+#if defined(__GLIBC__)
+    // The exception object allocated by __cxa_allocate_exception
+    const long runtime_mallocs = 1;
+#else
+    const long runtime_mallocs = malloc_count;
+#endif
+    bool ok = thrown && operator_new_count == 0 &&
+              malloc_count <= runtime_mallocs;
+    if (!ok)
+        ++failures;
+    std::printf(
+        "%-4s %-40s operator new: %ld, malloc: %ld (exception object)%s\n",
+        ok ? "ok" : "FAIL", name, operator_new_count, malloc_count,
+        thrown ? "" : ", not thrown");
+}
+
+// Element type with non-trivial special members
+struct Tracked {
+    Tracked() : value(0) {}
+    Tracked(int v) : value(v) {}
+    Tracked(const Tracked& other) : value(other.value) {}
+    Tracked(Tracked&& other) noexcept : value(other.value) { other.value = 0; }
+    Tracked& operator=(const Tracked& other) {
+        value = other.value;
+        return *this;
+    }
+    Tracked& operator=(Tracked&& other) noexcept {
+        value = other.value;
+        other.value = 0;
+        return *this;
+    }
+    ~Tracked() { value = -1; }
+    bool operator<(const Tracked& other) const { return value < other.value; }
+    bool operator==(const Tracked& other) const {
+        return value == other.value;
+    }
+
+    int value;
+};
+
+template <typename T> void check_all(const char* type) {
+    using vector = static_vector<T, 16>;
+    std::printf("static_vector<%s, 16>\n", type);
+    const T values[] = {5, 3, 8, 1, 9, 2};
+
+    check_no_alloc("default constructor", [] { vector v; });
+    check_no_alloc("count constructor", [] { vector v(8); });
+    check_no_alloc("count copies constructor", [] { vector v(8, T(1)); });
+    check_no_alloc("initializer list constructor", [] {
+        vector v{1, 2, 3};
+    });
+    check_no_alloc("iterator constructor", [&] {
+        vector v(std::begin(values), std::end(values));
+    });
+
+    vector source(std::begin(values), std::end(values));
+    check_no_alloc("copy constructor", [&] { vector v(source); });
+    check_no_alloc("copy assignment", [&] {
+        vector v;
+        v = source;
+    });
+    check_no_alloc("move constructor", [&] {
+        vector u(source);
+        vector v(std::move(u));
+    });
+    check_no_alloc("move assignment", [&] {
+        vector u(source);
+        vector v;
+        v = std::move(u);
+    });
+
+    check_no_alloc("assign", [&] {
+        vector v(3, T(1));
+        v.assign(8, T(2));
+        v.assign(std::begin(values), std::end(values));
+        v.assign({1, 2});
+        v = {3, 4, 5};
+    });
+
+    check_no_alloc("element access", [&] {
+        const vector& c = source;
+        volatile bool sink = &c.at(1) == &c[1] && &c.front() == c.data() &&
+                             &c.back() == c.end() - 1;
+        (void)sink;
+    });
+    check_no_alloc("find and contains", [&] {
+        volatile bool sink = source.find(source[1]) == source.begin() + 1 &&
+                             source.contains(T(1));
+        (void)sink;
+    });
+    check_no_alloc("iteration", [&] {
+        int sum = 0;
+        for (auto it = source.rbegin(); it != source.rend(); ++it)
+            sum += static_cast<int>(sizeof(*it));
+        volatile int sink = sum;
+        (void)sink;
+    });
+
+    check_no_alloc("push_back", [] {
+        vector v;
+        T value(1);
+        v.push_back(value);
+        v.push_back(T(2));
+        v.unchecked_push_back(value);
+        v.unchecked_push_back(T(3));
+    });
+    check_no_alloc("insert", [&] {
+        vector v(source);
+        T value(1);
+        v.insert(v.begin(), value);
+        v.insert(v.begin() + 2, T(2));
+        v.insert(v.end(), 2, value);
+        v.insert(v.begin() + 1, std::begin(values), std::begin(values) + 3);
+    });
+    check_no_alloc("emplace", [&] {
+        vector v(source);
+        v.emplace(v.begin() + 1, 7);
+    });
+    check_no_alloc("erase", [&] {
+        vector v(source);
+        v.erase(v.begin());
+        v.erase(v.end() - 1);
+    });
+    check_no_alloc("range erase and unordered_erase", [&] {
+        vector v(source);
+        v.unordered_erase(v.begin() + 1);
+        v.erase(v.begin() + 1, v.begin() + 3);
+    });
+    check_no_alloc("emplace_back and pop_back", [] {
+        vector v;
+        v.emplace_back(1);
+        v.emplace_back(2);
+        v.pop_back();
+    });
+    check_no_alloc("resize", [&] {
+        vector v(source);
+        v.resize(12);
+        v.resize(2);
+        v.resize(10, T(4));
+        v.resize(14, default_init);
+    });
+    check_no_alloc("swap", [&] {
+        vector u(source);
+        vector v(2, T(7));
+        u.swap(v);
+        swap(u, v);
+    });
+    check_no_alloc("clear", [&] {
+        vector v(source);
+        v.clear();
+    });
+
+    check_no_alloc("std::sort", [&] {
+        vector v(source);
+        std::sort(v.begin(), v.end());
+    });
+    check_no_alloc("std::rotate", [&] {
+        vector v(source);
+        std::rotate(v.begin(), v.begin() + 2, v.end());
+    });
+    check_no_alloc("std::back_inserter", [&] {
+        vector v;
+        std::copy(source.begin(), source.end(), std::back_inserter(v));
+    });
+
+    vector full(16, T(1));
+    check_throw_no_alloc("at() out of range", [&] { full.at(16); });
+    check_throw_no_alloc("push_back on full", [&] { full.push_back(T(1)); });
+    check_throw_no_alloc("insert on full", [&] {
+        full.insert(full.begin(), T(1));
+    });
+    check_throw_no_alloc("insert count on full", [&] {
+        full.insert(full.begin(), 2, T(1));
+    });
+    check_throw_no_alloc("insert range on full", [&] {
+        full.insert(full.begin(), std::begin(values), std::end(values));
+    });
+    check_throw_no_alloc("emplace on full", [&] {
+        full.emplace(full.begin(), 1);
+    });
+    check_throw_no_alloc("assign beyond capacity", [&] {
+        full.assign(17, T(1));
+    });
+    check_throw_no_alloc("emplace_back on full", [&] { full.emplace_back(1); });
+    check_throw_no_alloc("resize beyond capacity", [&] { full.resize(17); });
+}
+
+} // namespace
+
+int main(int, char*[]) {
+    check_all<int>("int");
+    check_all<Tracked>("Tracked");
+    if (failures)
+        std::printf("%d operation(s) allocated heap memory\n", failures);
+    return failures ? 1 : 0;
+}